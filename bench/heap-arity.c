@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "binheap.h"
+
+#ifndef BENCH_MIN
+#define BENCH_MIN 10000
+#endif
+
+/* Set to 100000000 to include 10^8 elements; that needs about 400MB. */
+#ifndef BENCH_MAX
+#define BENCH_MAX 10000000
+#endif
+
+#ifndef BENCH_SEED
+#define BENCH_SEED 1234
+#endif
+
+static int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t arities[] = { 2, 4, 8 };
+    struct binheap bh;
+    clock_t start;
+    double push, pop;
+    size_t n, a, i;
+    int e;
+
+    printf("%12s %6s %12s %12s\n", "elements", "arity", "push(Mop/s)",
+            "pop(Mop/s)");
+
+    for (n = BENCH_MIN; n <= BENCH_MAX; n *= 10)
+    {
+        for (a = 0; a < sizeof(arities) / sizeof(*arities); a++)
+        {
+            binheap_init_arity(&bh, cmp, sizeof(int), n, arities[a]);
+            srand(BENCH_SEED);
+
+            start = clock();
+            for (i = 0; i < n; i++)
+            {
+                e = rand();
+                binheap_push(&bh, &e);
+            }
+            push = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+            start = clock();
+            for (i = 0; i < n; i++)
+                binheap_pop(&bh);
+            pop = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+            printf("%12zu %6zu %12.2f %12.2f\n", n, arities[a],
+                    n / push / 1e6, n / pop / 1e6);
+
+            binheap_destroy(&bh);
+        }
+    }
+
+    return 0;
+}
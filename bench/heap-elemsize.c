@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "binheap.h"
+
+#ifndef BENCH_SIZE
+#define BENCH_SIZE 1000000
+#endif
+
+#ifndef BENCH_SEED
+#define BENCH_SEED 1234
+#endif
+
+/* Elements are compared by their first word; the rest is payload that must be
+ * moved along with it. */
+static int cmp(const void *a, const void *b)
+{
+    const unsigned long *_a = a, *_b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t sizes[] = { 8, 16, 64, 256 };
+    unsigned long e[256 / sizeof(unsigned long)] = { 0 };
+    struct binheap bh;
+    clock_t start;
+    double push, pop;
+    size_t s, i;
+
+    printf("%10s %12s %12s\n", "elemsize", "push(Mop/s)", "pop(Mop/s)");
+
+    for (s = 0; s < sizeof(sizes) / sizeof(*sizes); s++)
+    {
+        binheap_init(&bh, cmp, sizes[s], BENCH_SIZE, realloc);
+        srand(BENCH_SEED);
+
+        start = clock();
+        for (i = 0; i < BENCH_SIZE; i++)
+        {
+            e[0] = rand();
+            binheap_push(&bh, e);
+        }
+        push = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (i = 0; i < BENCH_SIZE; i++)
+            binheap_pop(&bh);
+        pop = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        printf("%10zu %12.2f %12.2f\n", sizes[s], BENCH_SIZE / push / 1e6,
+                BENCH_SIZE / pop / 1e6);
+
+        binheap_destroy(&bh);
+    }
+
+    return 0;
+}
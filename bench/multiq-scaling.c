@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "binheap.h"
+#include "multiq.h"
+
+#ifndef BENCH_OPS
+#define BENCH_OPS 4000000
+#endif
+
+#ifndef BENCH_PREFILL
+#define BENCH_PREFILL 1000000
+#endif
+
+#ifndef BENCH_MAX_THREADS
+#define BENCH_MAX_THREADS 16
+#endif
+
+/* Number of heaps per thread in the MultiQueue. */
+#ifndef BENCH_FACTOR
+#define BENCH_FACTOR 4
+#endif
+
+struct worker
+{
+    pthread_t thread;
+    uint64_t seed;
+    size_t ops;
+};
+
+static struct multiq mq;
+static struct binheap bh;
+static pthread_mutex_t bh_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int cmp(const void *a, const void *b)
+{
+    const uint64_t *_a = a, *_b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+/* Each operation pops an element and pushes a slightly later one back, like a
+ * worker pool scheduling timers. */
+static void *run_multiq(void *arg)
+{
+    struct worker *w = arg;
+    uint64_t e;
+    size_t i;
+
+    for (i = 0; i < w->ops; i++)
+    {
+        if (multiq_pop(&mq, &e, &w->seed) != 0)
+            e = 0;
+        e += 1 + w->seed % 1024;
+        multiq_push(&mq, &e, &w->seed);
+    }
+
+    return NULL;
+}
+
+static void *run_locked(void *arg)
+{
+    struct worker *w = arg;
+    uint64_t e;
+    size_t i;
+
+    for (i = 0; i < w->ops; i++)
+    {
+        w->seed = w->seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        pthread_mutex_lock(&bh_lock);
+        if (binheap_pop_into(&bh, &e) != 0)
+            e = 0;
+        e += 1 + (w->seed >> 33) % 1024;
+        binheap_push(&bh, &e);
+        pthread_mutex_unlock(&bh_lock);
+    }
+
+    return NULL;
+}
+
+/* Run 'fn' on 'nthreads' threads, splitting BENCH_OPS between them, and return
+ * the throughput in millions of operations per second. */
+static double measure(void *(*fn)(void *), unsigned nthreads)
+{
+    struct worker workers[BENCH_MAX_THREADS];
+    double start;
+    unsigned i;
+
+    start = now();
+    for (i = 0; i < nthreads; i++)
+    {
+        workers[i].seed = i + 1;
+        workers[i].ops = BENCH_OPS / nthreads;
+        pthread_create(&workers[i].thread, NULL, fn, &workers[i]);
+    }
+    for (i = 0; i < nthreads; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    return BENCH_OPS / (now() - start) / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t seed = 1, e;
+    unsigned nthreads;
+    double locked, multi;
+    size_t i;
+
+    printf("%d pop+push pairs on a queue of %d elements\n", BENCH_OPS,
+            BENCH_PREFILL);
+    printf("%8s %14s %14s %8s\n", "threads", "locked(Mop/s)", "multiq(Mop/s)",
+            "ratio");
+
+    for (nthreads = 1; nthreads <= BENCH_MAX_THREADS; nthreads *= 2)
+    {
+        binheap_init(&bh, cmp, sizeof(uint64_t), BENCH_PREFILL, realloc);
+        multiq_init(&mq, cmp, sizeof(uint64_t), BENCH_FACTOR * nthreads,
+                realloc);
+        for (i = 0; i < BENCH_PREFILL; i++)
+        {
+            e = i;
+            binheap_push(&bh, &e);
+            multiq_push(&mq, &e, &seed);
+        }
+
+        locked = measure(run_locked, nthreads);
+        multi = measure(run_multiq, nthreads);
+
+        printf("%8u %14.2f %14.2f %8.2f\n", nthreads, locked, multi,
+                multi / locked);
+
+        multiq_destroy(&mq);
+        binheap_destroy(&bh);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "pheap.h"
+#include "utils.h"
+
+#ifndef BENCH_SIZE
+#define BENCH_SIZE 10000000
+#endif
+
+#ifndef BENCH_SEED
+#define BENCH_SEED 1234
+#endif
+
+/* A small payload, like an event queue entry, so that the node header is a
+ * large part of each element. */
+struct node
+{
+    struct pheap_elem pe;
+    uint32_t key;
+};
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int cmp(const void *a, const void *b)
+{
+    const struct node *_a, *_b;
+
+    _a = containerof(a, struct node, pe);
+    _b = containerof(b, struct node, pe);
+
+    return (_a->key > _b->key) - (_a->key < _b->key);
+}
+
+int main(int argc, char *argv[])
+{
+    struct node *nodes, *n, *popped;
+    struct pheap ph;
+    double start, push, dec, pop;
+    uint32_t prev;
+    size_t i, j;
+
+    nodes = malloc(BENCH_SIZE * sizeof(*nodes));
+    if (nodes == NULL)
+        return 1;
+
+    printf("%d nodes, %zu byte header, %zu byte node, %.1f MB total\n",
+            BENCH_SIZE, sizeof(struct pheap_elem), sizeof(struct node),
+            BENCH_SIZE * sizeof(struct node) / 1e6);
+
+    srand(BENCH_SEED);
+    pheap_init(&ph, cmp);
+
+    start = now();
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        pheap_elem_init(&nodes[i].pe);
+        nodes[i].key = rand();
+        pheap_push(&ph, &nodes[i].pe);
+    }
+    push = now() - start;
+
+    /* Pop one node first, so that the heap is not a single flat list. */
+    popped = containerof(pheap_pop(&ph), struct node, pe);
+
+    start = now();
+    for (i = 0; i < BENCH_SIZE / 10; i++)
+    {
+        j = rand() % BENCH_SIZE;
+        if (&nodes[j] == popped)
+            continue;
+        nodes[j].key /= 2;
+        pheap_decrease_key(&ph, &nodes[j].pe);
+    }
+    dec = now() - start;
+
+    start = now();
+    prev = 0;
+    for (i = 1; i < BENCH_SIZE; i++)
+    {
+        n = containerof(pheap_pop(&ph), struct node, pe);
+        if (n->key < prev)
+            return 1;
+        prev = n->key;
+    }
+    pop = now() - start;
+
+    printf("%14s %10s %10s\n", "operation", "time(s)", "Mop/s");
+    printf("%14s %10.3f %10.2f\n", "push", push, BENCH_SIZE / push / 1e6);
+    printf("%14s %10.3f %10.2f\n", "decrease-key", dec,
+            BENCH_SIZE / 10 / dec / 1e6);
+    printf("%14s %10.3f %10.2f\n", "pop", pop, BENCH_SIZE / pop / 1e6);
+
+    free(nodes);
+
+    return 0;
+}
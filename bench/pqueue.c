@@ -0,0 +1,515 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "binheap.h"
+#include "fibheap.h"
+#include "iheap.h"
+#include "pheap.h"
+#include "radixheap.h"
+#include "utils.h"
+
+/* Number of elements on the queue during the run. */
+#ifndef BENCH_SIZE
+#define BENCH_SIZE 1000000
+#endif
+
+/* Number of pop+push pairs to run. */
+#ifndef BENCH_OPS
+#define BENCH_OPS 10000000
+#endif
+
+/* Number of decrease-keys tried after each pop in the decrease-key trace. */
+#ifndef BENCH_DEC
+#define BENCH_DEC 4
+#endif
+
+/* Range of the initial keys, and of the increments added to popped keys. */
+#ifndef BENCH_RANGE
+#define BENCH_RANGE 100000
+#endif
+
+#ifndef BENCH_SEED
+#define BENCH_SEED 1234
+#endif
+
+/*
+ * Every queue runs the same traces. The first is like an event simulation:
+ * BENCH_SIZE initial keys are pushed, then each step pops the minimum key and
+ * pushes it back plus the next increment. Popped keys never decrease, so the
+ * radix heap can run the trace too. The sum of the popped keys is printed to
+ * check that every queue did the same work.
+ *
+ * The second is like Dijkstra's algorithm, for the queues with decrease-key:
+ * the same BENCH_SIZE keys are pushed, then each step pops the minimum and
+ * lowers BENCH_DEC random keys, never below the popped key. Keys that were
+ * already popped are skipped. Ties are broken by the element's id, so every
+ * queue pops the elements in the same order, and a hash of that order is
+ * printed.
+ */
+struct trace
+{
+    uint64_t *init;
+    uint64_t *incs;
+    uint32_t *targets;
+    uint64_t *decs;
+};
+
+struct bin_elem
+{
+    uint64_t key;
+    uint32_t id;
+};
+
+struct pheap_node
+{
+    struct pheap_elem pe;
+    uint64_t key;
+    uint32_t id;
+};
+
+struct fib_node
+{
+    struct fibheap_elem fe;
+    uint64_t key;
+    uint32_t id;
+};
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int key_cmp(uint64_t ka, uint32_t ia, uint64_t kb, uint32_t ib)
+{
+    if (ka != kb)
+        return (ka > kb) - (ka < kb);
+
+    return (ia > ib) - (ia < ib);
+}
+
+static int bin_cmp(const void *a, const void *b)
+{
+    const struct bin_elem *_a = a, *_b = b;
+
+    return key_cmp(_a->key, _a->id, _b->key, _b->id);
+}
+
+static int pheap_cmp(const void *a, const void *b)
+{
+    const struct pheap_node *_a, *_b;
+
+    _a = containerof(a, struct pheap_node, pe);
+    _b = containerof(b, struct pheap_node, pe);
+
+    return key_cmp(_a->key, _a->id, _b->key, _b->id);
+}
+
+static int fib_cmp(const void *a, const void *b)
+{
+    const struct fib_node *_a, *_b;
+
+    _a = containerof(a, struct fib_node, fe);
+    _b = containerof(b, struct fib_node, fe);
+
+    return key_cmp(_a->key, _a->id, _b->key, _b->id);
+}
+
+/* Key after decreasing by dec, but never below the last popped key. */
+static uint64_t lowered(uint64_t key, uint64_t floor, uint64_t dec)
+{
+    return key - floor > dec ? key - dec : floor;
+}
+
+/* Fold the id of a popped element into the hash of the pop order. */
+static uint64_t hash_pop(uint64_t hash, uint32_t id)
+{
+    return hash * 1099511628211ULL + id;
+}
+
+static uint64_t run_binheap(const struct trace *t)
+{
+    struct binheap bh;
+    struct bin_elem e;
+    uint64_t sum = 0;
+    size_t i;
+
+    binheap_init(&bh, bin_cmp, sizeof(e), BENCH_SIZE, realloc);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        e.key = t->init[i];
+        e.id = i;
+        binheap_push(&bh, &e);
+    }
+
+    for (i = 0; i < BENCH_OPS; i++)
+    {
+        binheap_pop_into(&bh, &e);
+        sum += e.key;
+        e.key += t->incs[i];
+        binheap_push(&bh, &e);
+    }
+
+    binheap_destroy(&bh);
+
+    return sum;
+}
+
+static uint64_t run_binheap_replace(const struct trace *t)
+{
+    struct binheap bh;
+    struct bin_elem e, out;
+    uint64_t sum = 0;
+    size_t i;
+
+    binheap_init(&bh, bin_cmp, sizeof(e), BENCH_SIZE, realloc);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        e.key = t->init[i];
+        e.id = i;
+        binheap_push(&bh, &e);
+    }
+
+    for (i = 0; i < BENCH_OPS; i++)
+    {
+        e = *(struct bin_elem *)binheap_peek(&bh);
+        sum += e.key;
+        e.key += t->incs[i];
+        binheap_replace(&bh, &e, &out);
+    }
+
+    binheap_destroy(&bh);
+
+    return sum;
+}
+
+static uint64_t run_iheap(const struct trace *t)
+{
+    struct iheap ih;
+    struct bin_elem e;
+    uint64_t sum = 0;
+    size_t i;
+
+    iheap_init(&ih, bin_cmp, sizeof(e), BENCH_SIZE, realloc);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        e.key = t->init[i];
+        e.id = i;
+        iheap_push(&ih, &e);
+    }
+
+    for (i = 0; i < BENCH_OPS; i++)
+    {
+        e = *(struct bin_elem *)iheap_peek(&ih);
+        iheap_pop(&ih);
+        sum += e.key;
+        e.key += t->incs[i];
+        iheap_push(&ih, &e);
+    }
+
+    iheap_destroy(&ih);
+
+    return sum;
+}
+
+static uint64_t run_pheap(const struct trace *t)
+{
+    struct pheap_node *nodes, *n;
+    struct pheap ph;
+    uint64_t sum = 0;
+    size_t i;
+
+    nodes = malloc(BENCH_SIZE * sizeof(*nodes));
+    pheap_init(&ph, pheap_cmp);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        pheap_elem_init(&nodes[i].pe);
+        nodes[i].key = t->init[i];
+        nodes[i].id = i;
+        pheap_push(&ph, &nodes[i].pe);
+    }
+
+    for (i = 0; i < BENCH_OPS; i++)
+    {
+        n = containerof(pheap_pop(&ph), struct pheap_node, pe);
+        sum += n->key;
+        n->key += t->incs[i];
+        pheap_elem_init(&n->pe);
+        pheap_push(&ph, &n->pe);
+    }
+
+    free(nodes);
+
+    return sum;
+}
+
+static uint64_t run_fibheap(const struct trace *t)
+{
+    struct fib_node *nodes, *n;
+    struct fibheap fh;
+    uint64_t sum = 0;
+    size_t i;
+
+    nodes = malloc(BENCH_SIZE * sizeof(*nodes));
+    fibheap_init(&fh, fib_cmp);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        fibheap_elem_init(&nodes[i].fe);
+        nodes[i].key = t->init[i];
+        nodes[i].id = i;
+        fibheap_push(&fh, &nodes[i].fe);
+    }
+
+    for (i = 0; i < BENCH_OPS; i++)
+    {
+        n = containerof(fibheap_pop(&fh), struct fib_node, fe);
+        sum += n->key;
+        n->key += t->incs[i];
+        fibheap_push(&fh, &n->fe);
+    }
+
+    free(nodes);
+
+    return sum;
+}
+
+static uint64_t run_radixheap(const struct trace *t)
+{
+    struct radixheap rh;
+    uint64_t sum = 0, key;
+    uint32_t id;
+    size_t i;
+
+    radixheap_init(&rh, sizeof(id), realloc);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        id = i;
+        radixheap_push(&rh, t->init[i], &id);
+    }
+
+    for (i = 0; i < BENCH_OPS; i++)
+    {
+        radixheap_pop(&rh, &key, &id);
+        sum += key;
+        radixheap_push(&rh, key + t->incs[i], &id);
+    }
+
+    radixheap_destroy(&rh);
+
+    return sum;
+}
+
+static uint64_t dec_iheap(const struct trace *t)
+{
+    struct iheap ih;
+    struct bin_elem e, *cur;
+    uint64_t hash = 0, floor;
+    size_t i, j, h;
+
+    iheap_init(&ih, bin_cmp, sizeof(e), BENCH_SIZE, realloc);
+
+    /* The heap is fresh, so element i gets handle i. */
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        e.key = t->init[i];
+        e.id = i;
+        iheap_push(&ih, &e);
+    }
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        cur = iheap_peek(&ih);
+        floor = cur->key;
+        hash = hash_pop(hash, cur->id);
+        iheap_pop(&ih);
+
+        for (j = i * BENCH_DEC; j < (i + 1) * BENCH_DEC; j++)
+        {
+            h = t->targets[j];
+            if (!iheap_contains(&ih, h))
+                continue;
+
+            e = *(struct bin_elem *)iheap_get(&ih, h);
+            e.key = lowered(e.key, floor, t->decs[j]);
+            iheap_decrease_key(&ih, h, &e);
+        }
+    }
+
+    iheap_destroy(&ih);
+
+    return hash;
+}
+
+static uint64_t dec_pheap(const struct trace *t)
+{
+    struct pheap_node *nodes, *n;
+    struct pheap ph;
+    uint64_t hash = 0, floor;
+    size_t i, j;
+
+    nodes = malloc(BENCH_SIZE * sizeof(*nodes));
+    pheap_init(&ph, pheap_cmp);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        pheap_elem_init(&nodes[i].pe);
+        nodes[i].key = t->init[i];
+        nodes[i].id = i;
+        pheap_push(&ph, &nodes[i].pe);
+    }
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        n = containerof(pheap_pop(&ph), struct pheap_node, pe);
+        floor = n->key;
+        hash = hash_pop(hash, n->id);
+        n->key = UINT64_MAX;
+
+        for (j = i * BENCH_DEC; j < (i + 1) * BENCH_DEC; j++)
+        {
+            n = &nodes[t->targets[j]];
+            if (n->key == UINT64_MAX)
+                continue;
+
+            n->key = lowered(n->key, floor, t->decs[j]);
+            pheap_decrease_key(&ph, &n->pe);
+        }
+    }
+
+    free(nodes);
+
+    return hash;
+}
+
+static uint64_t dec_fibheap(const struct trace *t)
+{
+    struct fib_node *nodes, *n;
+    struct fibheap fh;
+    uint64_t hash = 0, floor;
+    size_t i, j;
+
+    nodes = malloc(BENCH_SIZE * sizeof(*nodes));
+    fibheap_init(&fh, fib_cmp);
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        fibheap_elem_init(&nodes[i].fe);
+        nodes[i].key = t->init[i];
+        nodes[i].id = i;
+        fibheap_push(&fh, &nodes[i].fe);
+    }
+
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        n = containerof(fibheap_pop(&fh), struct fib_node, fe);
+        floor = n->key;
+        hash = hash_pop(hash, n->id);
+        n->key = UINT64_MAX;
+
+        for (j = i * BENCH_DEC; j < (i + 1) * BENCH_DEC; j++)
+        {
+            n = &nodes[t->targets[j]];
+            if (n->key == UINT64_MAX)
+                continue;
+
+            n->key = lowered(n->key, floor, t->decs[j]);
+            fibheap_decrease_key(&fh, &n->fe);
+        }
+    }
+
+    free(nodes);
+
+    return hash;
+}
+
+struct queue
+{
+    const char *name;
+    uint64_t (*run)(const struct trace *t);
+};
+
+static const struct queue queues[] = {
+    { "binheap", run_binheap },
+    { "binheap-replace", run_binheap_replace },
+    { "fibheap", run_fibheap },
+    { "iheap", run_iheap },
+    { "pheap", run_pheap },
+    { "radixheap", run_radixheap },
+};
+
+static const struct queue dec_queues[] = {
+    { "fibheap", dec_fibheap },
+    { "iheap", dec_iheap },
+    { "pheap", dec_pheap },
+};
+
+static void run_all(const struct queue *q, size_t n, const struct trace *t,
+        double ops)
+{
+    uint64_t sum;
+    double start, secs;
+    size_t i;
+
+    printf("%16s %10s %12s %22s\n", "queue", "time(s)", "ops(Mop/s)",
+            "checksum");
+
+    for (i = 0; i < n; i++)
+    {
+        start = now();
+        sum = q[i].run(t);
+        secs = now() - start;
+
+        printf("%16s %10.3f %12.2f %22llu\n", q[i].name, secs,
+                ops / secs / 1e6, (unsigned long long)sum);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    struct trace t;
+    size_t i;
+
+    t.init = malloc(BENCH_SIZE * sizeof(*t.init));
+    t.incs = malloc(BENCH_OPS * sizeof(*t.incs));
+    t.targets = malloc(BENCH_SIZE * BENCH_DEC * sizeof(*t.targets));
+    t.decs = malloc(BENCH_SIZE * BENCH_DEC * sizeof(*t.decs));
+
+    srand(BENCH_SEED);
+    for (i = 0; i < BENCH_SIZE; i++)
+        t.init[i] = rand() % BENCH_RANGE;
+    for (i = 0; i < BENCH_OPS; i++)
+        t.incs[i] = rand() % BENCH_RANGE;
+    for (i = 0; i < BENCH_SIZE * BENCH_DEC; i++)
+    {
+        t.targets[i] = rand() % BENCH_SIZE;
+        t.decs[i] = rand() % BENCH_RANGE;
+    }
+
+    printf("%d elements, %d pop+push pairs\n", BENCH_SIZE, BENCH_OPS);
+    run_all(queues, lengthof(queues), &t, BENCH_OPS);
+
+    printf("\n%d elements, each pop followed by %d decrease-keys\n",
+            BENCH_SIZE, BENCH_DEC);
+    run_all(dec_queues, lengthof(dec_queues), &t,
+            (double)BENCH_SIZE * (BENCH_DEC + 1));
+
+    free(t.decs);
+    free(t.targets);
+    free(t.incs);
+    free(t.init);
+
+    return 0;
+}
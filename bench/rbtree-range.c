@@ -0,0 +1,163 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "rbtree.h"
+#include "utils.h"
+
+/* Number of nodes in the tree. */
+#ifndef BENCH_SIZE
+#define BENCH_SIZE 1000000
+#endif
+
+/* Number of range queries to run. */
+#ifndef BENCH_QUERIES
+#define BENCH_QUERIES 1000
+#endif
+
+/* Number of keys covered by each range. */
+#ifndef BENCH_WIDTH
+#define BENCH_WIDTH 256
+#endif
+
+#ifndef BENCH_SEED
+#define BENCH_SEED 1234
+#endif
+
+struct node
+{
+    struct rbnode rbn;
+    uint32_t key;
+};
+
+struct range
+{
+    uint32_t lo;
+    uint32_t hi;
+    uint64_t sum;
+};
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int cmp(const void *a, const void *b)
+{
+    const struct node *_a, *_b;
+
+    _a = containerof(a, struct node, rbn);
+    _b = containerof(b, struct node, rbn);
+
+    return (_a->key > _b->key) - (_a->key < _b->key);
+}
+
+static int sum_range(const struct rbnode *rbn, void *scratch)
+{
+    const struct node *n = containerof(rbn, struct node, rbn);
+    struct range *r = scratch;
+
+    if (n->key >= r->lo && n->key < r->hi)
+        r->sum += n->key;
+
+    return 0;
+}
+
+static uint64_t scan_traverse(const struct rbtree *tree, uint32_t lo)
+{
+    struct range r;
+
+    r.lo = lo;
+    r.hi = lo + BENCH_WIDTH;
+    r.sum = 0;
+    rbtree_traverse(tree, sum_range, &r);
+
+    return r.sum;
+}
+
+static uint64_t scan_iter(const struct rbtree *tree, uint32_t lo)
+{
+    struct rbiter it;
+    struct rbnode *rbn;
+    struct node key, *n;
+    uint64_t sum = 0;
+
+    key.key = lo;
+    for (rbn = rbtree_lower_bound(tree, &key.rbn, &it); rbn != NULL;
+            rbn = rbtree_next(&it))
+    {
+        n = containerof(rbn, struct node, rbn);
+        if (n->key >= lo + BENCH_WIDTH)
+            break;
+        sum += n->key;
+    }
+
+    return sum;
+}
+
+static const struct
+{
+    const char *name;
+    uint64_t (*scan)(const struct rbtree *tree, uint32_t lo);
+} scans[] = {
+    { "traverse", scan_traverse },
+    { "lower_bound+next", scan_iter },
+};
+
+int main(int argc, char *argv[])
+{
+    struct rbtree tree;
+    struct node *nodes;
+    uint32_t *starts;
+    uint64_t sum;
+    double start, secs;
+    size_t i, j;
+
+    nodes = malloc(BENCH_SIZE * sizeof(*nodes));
+    starts = malloc(BENCH_QUERIES * sizeof(*starts));
+    if (nodes == NULL || starts == NULL)
+    {
+        free(starts);
+        free(nodes);
+        return 1;
+    }
+
+    srand(BENCH_SEED);
+    rbtree_init(&tree, cmp);
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        nodes[i].key = ((uint64_t)i * 2654435761u) % BENCH_SIZE;
+        rbtree_insert(&tree, &nodes[i].rbn);
+    }
+    for (i = 0; i < BENCH_QUERIES; i++)
+        starts[i] = rand() % BENCH_SIZE;
+
+    printf("%d nodes, %d queries of %d keys\n", BENCH_SIZE, BENCH_QUERIES,
+            BENCH_WIDTH);
+    printf("%18s %10s %14s %16s\n", "scan", "time(s)", "us/query",
+            "checksum");
+
+    for (i = 0; i < lengthof(scans); i++)
+    {
+        sum = 0;
+        start = now();
+        for (j = 0; j < BENCH_QUERIES; j++)
+            sum += scans[i].scan(&tree, starts[j]);
+        secs = now() - start;
+
+        printf("%18s %10.3f %14.2f %16llu\n", scans[i].name, secs,
+                secs / BENCH_QUERIES * 1e6, (unsigned long long)sum);
+    }
+
+    free(starts);
+    free(nodes);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "vecpar.h"
+#include "vector.h"
+
+#ifndef BENCH_SIZE
+#define BENCH_SIZE 20000000
+#endif
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* A transform with enough arithmetic per element to be worth splitting up. */
+static void transform(void *e, size_t i, void *scratch)
+{
+    double *x = e;
+    double y = *x;
+    int k;
+
+    for (k = 0; k < 16; k++)
+        y = y * 0.999 + (double)(i & 7);
+
+    *x = y;
+}
+
+static void sum(void *acc, const void *e, size_t i, void *scratch)
+{
+    *(double *)acc += *(const double *)e;
+}
+
+static void combine(void *acc, const void *other, void *scratch)
+{
+    *(double *)acc += *(const double *)other;
+}
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    unsigned nthreads;
+    double start, map, reduce, base_map, base_reduce, total;
+    size_t i;
+
+    vec_init(&v, sizeof(double), BENCH_SIZE, realloc);
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        double x = (double)i;
+        vec_push(&v, &x);
+    }
+
+    printf("%d elements of %zu bytes\n", BENCH_SIZE, sizeof(double));
+    printf("%8s %10s %8s %10s %8s\n", "threads", "map(s)", "speedup",
+            "reduce(s)", "speedup");
+
+    base_map = base_reduce = 0;
+    for (nthreads = 1; nthreads <= 8; nthreads *= 2)
+    {
+        start = now();
+        vec_pmap(&v, transform, NULL, nthreads);
+        map = now() - start;
+
+        total = 0;
+        start = now();
+        vec_preduce(&v, &total, sizeof(total), sum, combine, NULL, nthreads);
+        reduce = now() - start;
+
+        if (nthreads == 1)
+        {
+            base_map = map;
+            base_reduce = reduce;
+        }
+
+        printf("%8u %10.4f %8.2f %10.4f %8.2f\n", nthreads, map,
+                base_map / map, reduce, base_reduce / reduce);
+    }
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "vector.h"
+
+#ifndef BENCH_SIZE
+#define BENCH_SIZE 10000000
+#endif
+
+#ifndef BENCH_CHUNK
+#define BENCH_CHUNK 65536
+#endif
+
+/* Allocation statistics gathered by the counting allocator below. */
+static size_t nalloc;
+static size_t nmoved;
+static size_t bytes_moved;
+static size_t last_size;
+
+/*
+ * Wrapper around realloc() that counts the number of calls, and how many of
+ * them had to move the buffer. This only tracks a single buffer at a time, which
+ * is all a single vector needs.
+ */
+static void *count_realloc(void *p, size_t size)
+{
+    void *ret;
+
+    ret = realloc(p, size);
+
+    if (size != 0)
+    {
+        nalloc++;
+        if (p != NULL && ret != p)
+        {
+            nmoved++;
+            bytes_moved += (last_size < size) ? last_size : size;
+        }
+        last_size = size;
+    }
+
+    return ret;
+}
+
+static void run(const char *name, vec_grow_func grow, size_t param)
+{
+    struct vector v;
+    clock_t start;
+    double secs;
+    size_t i;
+
+    nalloc = nmoved = bytes_moved = last_size = 0;
+
+    start = clock();
+
+    vec_init(&v, sizeof(size_t), 0, count_realloc);
+    vec_setgrowth(&v, grow, param);
+    for (i = 0; i < BENCH_SIZE; i++)
+        vec_push(&v, &i);
+
+    secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%-10s %8zu %8zu %14zu %12zu %8.3f\n", name, nalloc, nmoved,
+            bytes_moved, vec_space(&v) - vec_len(&v), secs);
+
+    vec_destroy(&v);
+}
+
+int main(int argc, char *argv[])
+{
+    printf("pushing %d elements of %zu bytes\n", BENCH_SIZE, sizeof(size_t));
+    printf("%-10s %8s %8s %14s %12s %8s\n", "policy", "allocs", "moves",
+            "bytes-moved", "slack", "seconds");
+
+    run("double", vec_grow_double, 0);
+    run("onehalf", vec_grow_onehalf, 0);
+    run("chunk", vec_grow_chunk, BENCH_CHUNK);
+
+    return 0;
+}
@@ -50,193 +50,260 @@
 #include <string.h>
 
 #include "binheap.h"
+#include "vecaligned.h"
+
+/**
+ * \brief Gets the number of children of each node in the heap.
+ *
+ * \param [in] bh Pointer to the heap.
+ *
+ * \return Returns the arity of the heap, which is always a power of two.
+ */
+#define _arity(bh)  ((size_t)1 << (bh)->shift)
 
 /**
  * \brief Gets the index of the node that is the parent of the node at the given
  * index.
  *
- * This assumes that the nodes of the binary tree are stored in an array. This
- * macro can be used to quickly find the parent of a given node in the array.
- * The argument 'i' must be strictly positive for this macro to work.
+ * This assumes that the nodes of the tree are stored in an array, with the root
+ * at the index 'r' (see #_child()). This macro can be used to quickly find the
+ * parent of a given node in the array. The argument 'i' must be strictly
+ * greater than 'r' for this macro to work.
  *
- * This operation assumes integer division. Specifically, the
- * parent node is at the index 'floor((i-1) / 2)'. Integer division
- * will automatically do the floor operation.
+ * The parent node is at the index 'floor((i-r-1) / d) + r', where 'd' is the
+ * arity of the heap. Since the arity is a power of two, the division is just a
+ * shift.
  *
+ * \param [in] bh Pointer to the heap.
  * \param [in] i Index of the node to get the parent of.
  *
  * \return Return the index of the parent of the given node.
  */
-#define _parent(i)  (((i) - 1) / 2)
+#define _parent(bh, i)  ((((i) - (bh)->root - 1) >> (bh)->shift) + (bh)->root)
 
 /**
- * \brief Gets the index of the left child of the node at the given index.
+ * \brief Gets the index of the first child of the node at the given index.
  *
- * This assumes that the elements of the tree are stored in an array. The
- * argument \p i should be non-negative.
+ * This assumes that the elements of the tree are stored in an array, with the
+ * root at the index 'r'. The argument \p i should be at least 'r'.
  *
- * Note that both children of a given node are located
- * sequentially. The left child is the one that is at the lower
- * index of the two.
+ * Note that all children of a given node are located sequentially, starting at
+ * the index 'd*(i-r) + r + 1', where 'd' is the arity of the heap. For a binary
+ * heap, this is the left child. Heaps created with #binheap_init_arity() put
+ * the root at 'r = d-1', so the first child is at 'd*(i-r+1)': every group of
+ * siblings starts at a multiple of 'd', and so shares a cache line.
  *
- * \param [in] i Index of the node to get the left child of.
+ * \param [in] bh Pointer to the heap.
+ * \param [in] i Index of the node to get the first child of.
  *
- * \return Returns the index of the left child of the given node.
+ * \return Returns the index of the first child of the given node.
  */
-#define _lchild(i)  (2*(i) + 1)
+#define _child(bh, i)   ((((i) - (bh)->root) << (bh)->shift) + (bh)->root + 1)
 
 /**
- * \brief Gets the index of the right child of the node at the given index.
- *
- * This assumes that the elements of the tree are stored in an array. The
- * argument \p i should be non-negative.
- *
- * Note that both children of a given node are located
- * sequentially. The right child is the one that is at the higher
- * index of the two.
+ * \brief Find the smallest child of a node.
  *
- * \param [in] i Index of the node to get the right child of.
+ * \param [in] bh Pointer to the heap.
+ * \param [in] c Index of the first child of the node; must be less than \p n.
+ * \param [in] n Number of elements in the heap.
  *
- * \return Returns the index of the right child of the given node.
+ * \return Returns the index of the smallest of the children of the node.
  */
-#define _rchild(i)  (2*(i) + 2)
+static size_t _minchild(const struct binheap *bh, size_t c, size_t n)
+{
+    const struct vector *v = &bh->vec;
+    size_t smallest = c;
+    size_t end;
+
+    /* The last node with children may not have all of them. */
+    end = c + _arity(bh);
+    if (end > n)
+        end = n;
+
+    for (c++; c < end; c++)
+    {
+        if (bh->cmp(vec_get(v, c), vec_get(v, smallest)) < 0)
+            smallest = c;
+    }
+
+    return smallest;
+}
 
 /**
- * \brief Sift a node up through the heap.
+ * \brief Sift an element up through the heap, starting from a hole.
  *
- * This function takes a node in the heap where the heap rooted at this node
- * satisifes the heap property, but the parent node may not. This function will
- * then sift the node upwards if needed until the heap property is restored.
+ * The node at index \p i is treated as a hole: its contents are ignored and
+ * will be overwritten. While the element \p e is smaller than the parent of
+ * the hole, the parent is moved down into the hole, and the hole moves up to
+ * where the parent was. Finally, \p e is written into the hole. Each level
+ * costs a single element copy, rather than the three needed to swap two nodes.
  *
- * Assumes that \p i is a valid index in the heap. The worst-case time
- * complexity of this function is <tt>O(log n)</tt>, where \p n is the number of
- * elements on the heap.
+ * The worst-case time complexity of this function is <tt>O(log n)</tt>, where
+ * \p n is the number of elements on the heap.
  *
- * Even though this function is recursive, GCC will use tail call
- * optimization to convert this to an iterative function.
- *
- * \param [in,out] bh Pointer to the binary heap to sift through.
- * \param [in] i Index of the node to sift upwards, if needed.
+ * \param [in,out] bh Pointer to the heap to sift through.
+ * \param [in] i Index of the hole to start from.
+ * \param [in] e Element to place in the heap. This must not point to any
+ *               node of the heap between \p i and the root.
  *
  * \pre <tt>bh != NULL</tt>
- * \pre <tt>i < vec_len(&(bh->vec))</tt>
+ * \pre <tt>bh->root <= i && i < vec_len(&(bh->vec))</tt>
  */
-static void _siftup(struct binheap *bh, size_t i)
+static void _siftup(struct binheap *bh, size_t i, const void *e)
 {
     /* The code below will look cleaner if we keep a pointer to the vector in a
      * local variable */
     struct vector *v;
 
-    /* Index of the parent of the current node. */
+    /* Index of the parent of the hole. */
     size_t p;
 
     assert(bh != NULL);
-    assert(i < vec_len(&(bh->vec)));
+    assert(bh->root <= i && i < vec_len(&(bh->vec)));
 
     v = &(bh->vec);
-    p = _parent(i);
-
-    /*
-     * Check to make sure the current node is not at the root (otherwise, the
-     * parent node does not exist). Then, if the current node is smaller than
-     * its parent, we need to swap them.
-     */
-    if (i > 0 && bh->cmp(vec_get(v, i), vec_get(v, p)) < 0)
+
+    /* Move parents down into the hole until the hole reaches the root, or its
+     * parent is no bigger than the new element. */
+    while (i > bh->root)
     {
-        /* Swap the current node with its parent. */
-        vec_swap(v, i, p);
+        p = _parent(bh, i);
+        if (bh->cmp(e, vec_get(v, p)) >= 0)
+            break;
 
-        /* Continue to sift the same node up the heap until the heap property is
-         * restored. */
-        _siftup(bh, p);
+        vec_set(v, i, vec_get(v, p));
+        i = p;
     }
+
+    vec_set(v, i, e);
 }
 
 /**
- * \brief Sift a node down through the heap.
+ * \brief Sift an element down through the heap, starting from a hole.
  *
- * This function takes in a node in a heap, where the node may violate the heap
- * property, then sifts its value down the heap in order to satisfy the heap
- * property. Note that both children of this root must satisfy the heap
- * property.
- *
- * This function assumes that the root node in the heap may violate
- * the heap property (i.e. it is greater than one of its children),
- * but heap rooted at both of its children still satisfy this
- * property. Assumes that 'i' is a valid index.
+ * The node at index \p i is treated as a hole in a heap of \p n elements,
+ * where the subheaps rooted at the children of the hole satisfy the heap
+ * property. While the smallest child of the hole is smaller than \p e, it is
+ * moved up into the hole, and the hole moves down to where that child was.
+ * Finally, \p e is written into the hole.
  *
  * The worst-case time complexity of this function is <tt>O(log n)</tt>,
  * where \p n is the number of elements on the heap.
  *
- * Even though this function is recursive, GCC will use tail call
- * optimization to convert this to an iterative function.
- *
- * \param [in,out] bh Pointer to the heap to sift through
- * \param [in] i Index of the node to use a the root of an invalid binary heap.
+ * \param [in,out] bh Pointer to the heap to sift through.
+ * \param [in] i Index of the hole to start from.
+ * \param [in] n Number of elements in the heap; any nodes of the vector past
+ *               this are left alone.
+ * \param [in] e Element to place in the heap. This must not point to any of
+ *               the first \p n nodes of the heap.
  *
  * \pre <tt>bh != NULL</tt>
- * \pre <tt>i < vec_len(&(bh->vec))</tt>
+ * \pre <tt>i < n && n <= vec_len(&(bh->vec))</tt>
  */
-static void _siftdown(struct binheap *bh, size_t i)
+static void _siftdown(struct binheap *bh, size_t i, size_t n, const void *e)
 {
-    /* The code below will look cleaner if we keep a pointer to the vector in a
-     * local variable */
     struct vector *v;
-
-    /* Indices of the left and right children of the root node at i. */
-    size_t l;
-    size_t r;
-
-    /*
-     * Index of the node that is the smallest of the root and its children.
-     * Initialize it to the root, so that it only needs to be changed if one of
-     * the children is smaller.
-     */
-    size_t smallest = i;
+    size_t c;
 
     assert(bh != NULL);
-    assert(vec_isempty(&bh->vec) || i < vec_len(&(bh->vec)));
+    assert(i < n && n <= vec_len(&(bh->vec)));
 
     v = &(bh->vec);
-    l = _lchild(i);
-    r = _rchild(i);
 
-    /* Nothing to do if the vector is empty. */
-    if (vec_isempty(v))
-        return;
-
-    /* Check if the left child exists and the root node is greater than its
-     * left child. */
-    if (l < vec_len(v) &&
-            bh->cmp(vec_get(v, l), vec_get(v, i)) < 0)
+    /* Move the smallest child up into the hole until the hole is a leaf, or
+     * none of its children are smaller than the new element. */
+    while ((c = _child(bh, i)) < n)
     {
-        /* The left child is smaller than the parent. Store it here. */
-        smallest = l;
+        c = _minchild(bh, c, n);
+        if (bh->cmp(vec_get(v, c), e) >= 0)
+            break;
+
+        vec_set(v, i, vec_get(v, c));
+        i = c;
     }
 
-    /* Next, check if the right child exists and the smallest node is
-     * greater than the right child. */
-    if (r < vec_len(v) &&
-            bh->cmp(vec_get(v, r), vec_get(v, smallest)) < 0)
+    vec_set(v, i, e);
+}
+
+/**
+ * \brief Sift the node at index \p i down through the heap by swapping.
+ *
+ * This does the same job as #_siftdown(), but swaps the node with its smallest
+ * child at each level rather than moving a hole, so it needs no copy of the
+ * node. Each level costs three element copies instead of one, so this is only
+ * used for elements too big to copy out.
+ *
+ * \param [in,out] bh Pointer to the heap to sift through.
+ * \param [in] i Index of the node to sift down.
+ * \param [in] n Number of elements in the heap.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>i < n && n <= vec_len(&(bh->vec))</tt>
+ */
+static void _siftdown_swap(struct binheap *bh, size_t i, size_t n)
+{
+    struct vector *v;
+    size_t c;
+
+    assert(bh != NULL);
+    assert(i < n && n <= vec_len(&(bh->vec)));
+
+    v = &(bh->vec);
+
+    while ((c = _child(bh, i)) < n)
     {
-        /* If so, right child is the smallest of the three. Store this new
-         * index here. */
-        smallest = r;
+        c = _minchild(bh, c, n);
+        if (bh->cmp(vec_get(v, c), vec_get(v, i)) >= 0)
+            break;
+
+        vec_swap(v, i, c);
+        i = c;
     }
+}
 
-    /*
-     * If the root node is not the smallest, then swap it with the smallest
-     * node. Now we have a new heap that needs to be sifted, with the root
-     * node at index i.
-     */
-    if (smallest != i)
-    {
-        /* Swap the root down the heap. */
-        vec_swap(v, i, smallest);
+/**
+ * \brief Refill the hole at the root of the heap, using bottom-up sifting.
+ *
+ * This is the variant of #_siftdown() due to Wegener, used for popping. The
+ * element that replaces the root is usually the last one in the heap, which
+ * almost always belongs near the bottom again. So instead of comparing \p e
+ * against the smallest child at each level, the hole is first moved all the
+ * way down to a leaf along the path of smallest children, without looking at
+ * \p e at all. Then \p e is sifted up from the leaf, which normally takes only
+ * a level or two. For a binary heap, this saves almost half of the
+ * comparisons made by #_siftdown().
+ *
+ * \param [in,out] bh Pointer to the heap to sift through.
+ * \param [in] n Number of elements in the heap.
+ * \param [in] e Element to place in the heap. This must not point to any of
+ *               the first \p n nodes of the heap.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>bh->root < n && n <= vec_len(&(bh->vec))</tt>
+ */
+static void _siftroot(struct binheap *bh, size_t n, const void *e)
+{
+    struct vector *v;
+    size_t i;
+    size_t c;
+
+    assert(bh != NULL);
+    assert(bh->root < n && n <= vec_len(&(bh->vec)));
+
+    i = bh->root;
+
+    v = &(bh->vec);
 
-        /* Then sift it again until the heap property is restored. */
-        _siftdown(bh, smallest);
+    /* Walk the hole down to a leaf. */
+    while ((c = _child(bh, i)) < n)
+    {
+        c = _minchild(bh, c, n);
+        vec_set(v, i, vec_get(v, c));
+        i = c;
     }
+
+    /* Then put the element back where it belongs on the path. */
+    _siftup(bh, i, e);
 }
 
 /**
@@ -266,21 +333,12 @@ static int _checkheap(const struct binheap *bh)
 
     v = &(bh->vec);
 
-    /* Iterate over every element of the binheap (up to the parent of the last
-     * element), ensuring that every element is less than or equal to its
-     * children. */
-    for (i = 0; i < vec_len(v); i++)
+    /* Iterate over every element of the heap except the root, ensuring that
+     * every element is greater than or equal to its parent. */
+    for (i = bh->root + 1; i < vec_len(v); i++)
     {
-        if (_lchild(i) < vec_len(v)
-                && bh->cmp(vec_get(v, i), vec_get(v, _lchild(i))) > 0)
-        {
-            rc++;
-        }
-        if (_rchild(i) < vec_len(v)
-                && bh->cmp(vec_get(v, i), vec_get(v, _rchild(i))) > 0)
-        {
+        if (bh->cmp(vec_get(v, _parent(bh, i)), vec_get(v, i)) > 0)
             rc++;
-        }
     }
 
     /* rc contains a count of the violations; want to see if the number of
@@ -326,12 +384,199 @@ int binheap_init(struct binheap *bh, cmp_func cmp, size_t elemsize,
 
     /* Store the comparison function in the binheap struct. */
     bh->cmp = cmp;
+    bh->shift = 1;
+    bh->root = 0;
 
     /* Initialize the vector. Note that the size argument can be passed
      * directly, and the return value can be returned from here. */
     return vec_init(&(bh->vec), elemsize, size, alloc);
 }
 
+/**
+ * \brief Initialize a d-ary heap so that it is ready to be used.
+ *
+ * This is the same as #binheap_init(), except that each node of the heap has
+ * \p arity children instead of two. A wider heap is shallower, so sifting an
+ * element down touches fewer levels (and so fewer cache lines) at the cost of
+ * comparing more children at each level. Wider heaps tend to be faster for
+ * large heaps of small elements; pushing is always cheaper, since it only
+ * compares against the parent at each level.
+ *
+ * The children of a node are stored next to each other. The vector is aligned
+ * to #BINHEAP_CACHE_LINE bytes, and the root is stored after <tt>arity -
+ * 1</tt> unused slots, so that each group of siblings starts at a multiple of
+ * \p arity. When the element size is a power of two, each group of siblings
+ * then fits in a single cache line, or starts on one if it is bigger. The
+ * unused slots cost <tt>arity - 1</tt> elements of memory per heap.
+ *
+ * \param bh Pointer to the heap to initialize.
+ * \param cmp Function for comparing two elements of the heap to determine which
+ *        is smaller.
+ * \param elemsize Size of each element on the heap.
+ * \param size Initial number of elements in the vector, or \c 0 for the
+ *             default.
+ * \param arity Number of children of each node. Must be a power of two, up to
+ *              #BINHEAP_MAX_ARITY.
+ *
+ * \return If memory is successfully allocated for the vector, returns \c 0. If
+ * the memory allocation fails, returns \c -1.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>cmp != NULL</tt>
+ * \pre \p arity is a power of two, and <tt>2 <= arity <= BINHEAP_MAX_ARITY</tt>
+ */
+int binheap_init_arity(struct binheap *bh, cmp_func cmp, size_t elemsize,
+        size_t size, size_t arity)
+{
+    int rc;
+
+    assert(bh != NULL);
+    assert(cmp != NULL);
+    assert(arity >= 2 && arity <= BINHEAP_MAX_ARITY);
+    assert((arity & (arity - 1)) == 0);
+
+    bh->cmp = cmp;
+
+    /* Store the arity as its base-2 logarithm. */
+    for (bh->shift = 0; ((size_t)1 << bh->shift) < arity; bh->shift++)
+        ;
+
+    /* Skip enough slots that the children of each node start at a multiple of
+     * the arity. */
+    bh->root = arity - 1;
+
+    if (size == 0)
+        size = DEF_BINHEAP_LEN;
+
+    rc = vec_init_aligned(&(bh->vec), elemsize, bh->root + size,
+            BINHEAP_CACHE_LINE, 0);
+
+    /* The unused slots are never read, so there is nothing to put in them. */
+    if (rc == 0)
+        bh->vec.len = bh->root;
+
+    return rc;
+}
+
+/**
+ * \brief Initialize a binary heap holding a copy of the given array of
+ * elements.
+ *
+ * The \p n elements at \p buf are copied into the heap's vector in a single
+ * pass, then arranged into a heap with #binheap_heapify(). This takes O(n)
+ * time, rather than the O(n log n) time needed to push each element in turn.
+ *
+ * \param bh Pointer to the binary heap to initialize.
+ * \param cmp Function for comparing two elements of the heap.
+ * \param elemsize Size of each element on the heap.
+ * \param buf Array of \p n elements to copy onto the heap.
+ * \param n Number of elements in \p buf.
+ * \param alloc Memory allocator used for preforming all allocation for the
+ *              binary heap. Interface should be equivalent to \c realloc.
+ *
+ * \return If memory is successfully allocated for the vector, returns \c 0. If
+ * the memory allocation fails, returns \c -1.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>cmp != NULL</tt>
+ *
+ * \post Heap property holds.
+ */
+int binheap_init_from(struct binheap *bh, cmp_func cmp, size_t elemsize,
+        const void *buf, size_t n, void *(*alloc)(void *, size_t))
+{
+    struct vector v;
+    int rc;
+
+    assert(bh != NULL);
+    assert(cmp != NULL);
+    assert(buf != NULL || n == 0);
+
+    /* Size the vector to fit the elements exactly, so they are copied in with
+     * a single allocation. */
+    rc = vec_init(&v, elemsize, n, alloc);
+    if (rc == 0)
+    {
+        rc = vec_extend(&v, buf, n);
+        if (rc == 0)
+            binheap_heapify(bh, cmp, &v);
+        else
+            vec_destroy(&v);
+    }
+
+    return rc;
+}
+
+/**
+ * \brief Turn a vector of elements into a binary heap.
+ *
+ * The heap takes over the storage of the vector \p v, which must not be used
+ * again afterwards (it should not be destroyed either; call #binheap_destroy()
+ * on the heap instead). The elements are then rearranged in place using
+ * Floyd's bottom-up heap construction: each node that has children is sifted
+ * down, starting from the last one and working back to the root. Since most
+ * nodes are near the bottom of the heap and only sift a short distance, this
+ * takes O(n) time in total. The resulting heap is binary.
+ *
+ * Each node is copied out into a local buffer, leaving a hole to sift down, so
+ * no memory is allocated and the vector is never grown. Elements bigger than
+ * #BINHEAP_HOLE_MAX bytes do not fit in the buffer, and are sifted down by
+ * swapping instead.
+ *
+ * \param bh Pointer to the binary heap to initialize.
+ * \param cmp Function for comparing two elements of the heap.
+ * \param v Vector holding the elements of the heap, in any order.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>cmp != NULL</tt>
+ * \pre <tt>v != NULL</tt>
+ *
+ * \post Heap property holds.
+ */
+void binheap_heapify(struct binheap *bh, cmp_func cmp, struct vector *v)
+{
+    union
+    {
+        unsigned char bytes[BINHEAP_HOLE_MAX];
+        long double ld;
+        long long ll;
+        void *p;
+    } hole;
+    size_t i;
+    size_t n;
+
+    assert(bh != NULL);
+    assert(cmp != NULL);
+    assert(v != NULL);
+
+    n = vec_len(v);
+
+    bh->cmp = cmp;
+    bh->shift = 1;
+    bh->root = 0;
+    bh->vec = *v;
+
+    /* Nodes after the parent of the last node are leaves, which are already
+     * heaps. Each other node is sifted down, starting from the last one. */
+    if (n > 1)
+    {
+        for (i = _parent(bh, n - 1) + 1; i > 0; i--)
+        {
+            if (bh->vec.elemsize <= BINHEAP_HOLE_MAX)
+            {
+                memcpy(&hole, vec_get(&bh->vec, i - 1), bh->vec.elemsize);
+                _siftdown(bh, i - 1, n, &hole);
+            }
+            else
+            {
+                _siftdown_swap(bh, i - 1, n);
+            }
+        }
+    }
+
+    assert(_checkheap(bh));
+}
+
 /**
  * \brief Free all the dynamically-allocated memory associated with the given
  * binary heap.
@@ -381,7 +626,7 @@ void binheap_destroy(struct binheap *bh)
  * \note This operation has a worst-case time complexity of O(log n) with
  * respect to the size of the heap.
  */
-int binheap_push(struct binheap *bh, void *e)
+int binheap_push(struct binheap *bh, const void *e)
 {
     int rc;     /* Variable for holding the return code from pushing the element
                    onto the vector. */
@@ -397,7 +642,7 @@ int binheap_push(struct binheap *bh, void *e)
     if (rc != -1)
     {
         /* Sift the element upwards until the heap property is restored. */
-        _siftup(bh, vec_len(&(bh->vec)) - 1);
+        _siftup(bh, vec_len(&(bh->vec)) - 1, e);
         assert(_checkheap(bh));
     }
 
@@ -411,9 +656,10 @@ int binheap_push(struct binheap *bh, void *e)
  * After the element is removed, the element at the tail of the heap is moved to
  * the top, then sifted down in order to restore the heap property. Since this
  * is a minheap, the element will be sifted into a place where both children are
- * greater than it. If there are no elements on the heap, returns -1. In order
- * to get the minimum element without removing it, use the #binheap_peek()
- * function.
+ * greater than it. The sift is done bottom-up, which needs about half as many
+ * comparisons as the usual top-down sift. If there are no elements on the
+ * heap, returns -1. In order to get the minimum element without removing it,
+ * use the #binheap_peek() function.
  *
  * \param bh Pointer to the heap to pop an element off of.
  *
@@ -440,18 +686,18 @@ int binheap_pop(struct binheap *bh)
     v = &bh->vec;
 
     /* If the heap is empty, we have nothing to do. */
-    if (vec_isempty(v))
+    if (binheap_isempty(bh))
     {
         rc = -1;
     }
-    /* Otherwise, swap the first and last elements, pop the last (this is the
-     * minimal element on the heap), then sift the first element down.
-     */
+    /* Otherwise, the root is a hole; refill it with the last element. The last
+     * node is outside of the shrunken heap, so it is left in place until the
+     * sift is finished, then popped. */
     else
     {
-        vec_swap(v, 0, vec_len(v) - 1);
+        if (vec_len(v) > bh->root + 1)
+            _siftroot(bh, vec_len(v) - 1, vec_tail(v));
         vec_pop(v);
-        _siftdown(bh, 0);
 
         rc = 0;
     }
@@ -461,6 +707,133 @@ int binheap_pop(struct binheap *bh)
     return rc;
 }
 
+/**
+ * \brief Copy the minimum element out of the heap, then remove it.
+ *
+ * This is the same as #binheap_pop(), except that the minimum element is first
+ * copied to \p buf. The pointer returned by #binheap_peek() is overwritten by
+ * the pop, so this is the only way to keep the element.
+ *
+ * \param bh Pointer to the heap to pop an element off of.
+ * \param buf Buffer to copy the minimum element to.
+ *
+ * \return Returns 0 if the operation succeeds (i.e. the heap is nonempty).
+ * Returns -1 if the heap is empty, in which case \p buf is not changed.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>buf != NULL</tt>
+ * \pre Heap property holds.
+ *
+ * \post Heap property holds.
+ */
+int binheap_pop_into(struct binheap *bh, void *buf)
+{
+    assert(bh != NULL);
+    assert(buf != NULL);
+
+    if (binheap_isempty(bh))
+        return -1;
+
+    memcpy(buf, binheap_peek(bh), bh->vec.elemsize);
+
+    return binheap_pop(bh);
+}
+
+/**
+ * \brief Push an element onto the heap, then pop the minimum element.
+ *
+ * This gives the same result as #binheap_push() followed by
+ * #binheap_pop_into(), but only needs a single sift. If \p e is no bigger than
+ * the minimum of the heap, it would be popped again straight away, so it is
+ * just copied to \p out and the heap is not changed at all. Otherwise, the
+ * minimum is copied to \p out and \p e takes its place at the root, then is
+ * sifted down. This never needs more memory, so it cannot fail.
+ *
+ * \param bh Pointer to the heap.
+ * \param e Element to push onto the heap.
+ * \param out Buffer to copy the popped element to. Must not overlap \p e.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ * \pre <tt>out != NULL</tt>
+ * \pre Heap property holds.
+ *
+ * \post Heap property holds.
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+void binheap_pushpop(struct binheap *bh, const void *e, void *out)
+{
+    struct vector *v;
+
+    assert(bh != NULL);
+    assert(e != NULL);
+    assert(out != NULL);
+    assert(_checkheap(bh));
+
+    v = &bh->vec;
+
+    if (binheap_isempty(bh) || bh->cmp(e, binheap_peek(bh)) <= 0)
+    {
+        memcpy(out, e, v->elemsize);
+    }
+    else
+    {
+        memcpy(out, binheap_peek(bh), v->elemsize);
+        _siftdown(bh, bh->root, vec_len(v), e);
+    }
+
+    assert(_checkheap(bh));
+}
+
+/**
+ * \brief Pop the minimum element from the heap, then push an element.
+ *
+ * This gives the same result as #binheap_pop_into() followed by
+ * #binheap_push(), but only needs a single sift: the minimum is copied to \p
+ * out, then \p e takes its place at the root and is sifted down. Unlike
+ * #binheap_pushpop(), the new element is always added, even if it is smaller
+ * than everything on the heap. This never needs more memory.
+ *
+ * \param bh Pointer to the heap.
+ * \param e Element to push onto the heap.
+ * \param out Buffer to copy the popped element to, or \c NULL if it is not
+ *            needed. Must not overlap \p e.
+ *
+ * \return Returns 0 if the operation succeeds. Returns -1 if the heap is
+ * empty, in which case nothing is changed.
+ *
+ * \pre <tt>bh != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ * \pre Heap property holds.
+ *
+ * \post Heap property holds.
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+int binheap_replace(struct binheap *bh, const void *e, void *out)
+{
+    struct vector *v;
+
+    assert(bh != NULL);
+    assert(e != NULL);
+    assert(_checkheap(bh));
+
+    v = &bh->vec;
+
+    if (binheap_isempty(bh))
+        return -1;
+
+    if (out != NULL)
+        memcpy(out, binheap_peek(bh), v->elemsize);
+
+    _siftroot(bh, vec_len(v), e);
+
+    assert(_checkheap(bh));
+
+    return 0;
+}
+
 /**
  * \brief Get the total number of elements currently stored on the binary heap.
  *
@@ -477,7 +850,7 @@ size_t binheap_len(const struct binheap *bh)
 {
     assert(bh != NULL);
 
-    return vec_len(&(bh->vec));
+    return vec_len(&(bh->vec)) - bh->root;
 }
 
 /**
@@ -502,7 +875,7 @@ size_t binheap_space(const struct binheap *bh)
 {
     assert(bh != NULL);
 
-    return vec_space(&(bh->vec));
+    return vec_space(&(bh->vec)) - bh->root;
 }
 
 /**
@@ -512,8 +885,8 @@ size_t binheap_space(const struct binheap *bh)
  *
  * \param bh Pointer to the binary heap to check for emptiness.
  *
- * \return If the number of elements in the vector is \c 0, returns true. Else,
- * returns false.
+ * \return If there are no elements on the heap, returns true. Else, returns
+ * false.
  *
  * \pre <tt>bh != NULL</tt>
  */
@@ -521,7 +894,7 @@ int binheap_isempty(const struct binheap *bh)
 {
     assert(bh != NULL);
 
-    return vec_isempty(&(bh->vec));
+    return vec_len(&(bh->vec)) == bh->root;
 }
 
 /**
@@ -545,6 +918,9 @@ void *binheap_peek(const struct binheap *bh)
 {
     assert(bh != NULL);
 
-    return vec_head(&(bh->vec));
+    if (binheap_isempty(bh))
+        return NULL;
+
+    return vec_get(&(bh->vec), bh->root);
 }
 
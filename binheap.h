@@ -37,6 +37,10 @@
  * addition, each node is less than or equal to both of its children, according
  * to the given comparison function; this makes the heap into a min heap. If a
  * max heap is desired, negate the value returned by the compare function.
+ *
+ * The heap may also be created as a d-ary heap with #binheap_init_arity(), in
+ * which every node has \c d children instead of two. All other operations work
+ * the same way on either kind of heap.
  */
 
 #ifndef _BINHEAP_H_
@@ -51,6 +55,23 @@
  */
 #define DEF_BINHEAP_LEN  DEF_VEC_LEN
 
+/**
+ * Largest number of children per node supported by #binheap_init_arity().
+ */
+#define BINHEAP_MAX_ARITY 64
+
+/**
+ * Alignment of the vector of a heap created by #binheap_init_arity(). Groups of
+ * siblings are laid out so that they do not straddle blocks of this size.
+ */
+#define BINHEAP_CACHE_LINE 64
+
+/**
+ * Largest element, in bytes, that #binheap_heapify() copies into a local buffer
+ * while sifting. Bigger elements are sifted by swapping instead.
+ */
+#define BINHEAP_HOLE_MAX 256
+
 
 /**
  * \brief Memory for storing a binary heap.
@@ -85,13 +106,25 @@ struct binheap
     cmp_func cmp;      /**< Comparison function used for sorting the elements on
                             the heap. This function will be passed pointer to
                             elements in the heap as arguments. */
+    unsigned shift;    /**< Base-2 logarithm of the number of children of each
+                            node; \c 1 for a binary heap. */
+    size_t root;       /**< Index of the root in the vector. The slots before it
+                            are unused padding. */
 };
 
 
 int binheap_init(struct binheap *bh, cmp_func cmp, size_t elemsize,
         size_t size, void *(*alloc)(void *, size_t));
-int binheap_push(struct binheap *bh, void *e);
+int binheap_init_arity(struct binheap *bh, cmp_func cmp, size_t elemsize,
+        size_t size, size_t arity);
+int binheap_init_from(struct binheap *bh, cmp_func cmp, size_t elemsize,
+        const void *buf, size_t n, void *(*alloc)(void *, size_t));
+void binheap_heapify(struct binheap *bh, cmp_func cmp, struct vector *v);
+int binheap_push(struct binheap *bh, const void *e);
 int binheap_pop(struct binheap *bh);
+int binheap_pop_into(struct binheap *bh, void *buf);
+void binheap_pushpop(struct binheap *bh, const void *e, void *out);
+int binheap_replace(struct binheap *bh, const void *e, void *out);
 void binheap_destroy(struct binheap *bh);
 size_t binheap_len(const struct binheap *bh);
 size_t binheap_space(const struct binheap *bh);
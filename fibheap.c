@@ -0,0 +1,502 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file fibheap.c
+ *
+ * \brief Fibonacci heaps.
+ *
+ * A Fibonacci heap is a collection of heap-ordered trees whose roots are kept
+ * in a circular list. Pushing and merging just add trees to the root list,
+ * and decreasing a key cuts the node out of its tree, so all three take O(1)
+ * amortized time. The trees are only tidied up when the minimum is popped:
+ * trees of equal degree are linked together until every root has a different
+ * degree, which takes O(log n) amortized time.
+ *
+ * Fibonacci heaps were invented by Fredman and Tarjan. For more information,
+ * see "Fibonacci Heaps and Their Uses in Improved Network Optimization
+ * Algorithms" (J. ACM 34(3), 1987).
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#include <assert.h>
+#include <stddef.h>
+
+#include "fibheap.h"
+#include "utils.h"
+
+/**
+ * \brief Join two circular lists of siblings into one.
+ *
+ * \param [in] a Any node in the first list.
+ * \param [in] b Any node in the second list.
+ *
+ * \pre \p a and \p b are in different lists.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+static void _splice(struct fibheap_elem *a, struct fibheap_elem *b)
+{
+    struct fibheap_elem *a_right, *b_left;
+
+    a_right = a->right;
+    b_left = b->left;
+
+    a->right = b;
+    b->left = a;
+    b_left->right = a_right;
+    a_right->left = b_left;
+}
+
+/**
+ * \brief Remove a node from its circular list of siblings.
+ *
+ * The node is left in a list of its own.
+ *
+ * \param [in] fe Node to unlink.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+static void _unlink(struct fibheap_elem *fe)
+{
+    fe->left->right = fe->right;
+    fe->right->left = fe->left;
+    fe->left = fe;
+    fe->right = fe;
+}
+
+/**
+ * \brief Make one root a child of another.
+ *
+ * \param [in] child Root to link below \p parent; removed from the root list.
+ * \param [in] parent Root that becomes the parent of \p child.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+static void _link(struct fibheap_elem *child, struct fibheap_elem *parent)
+{
+    _unlink(child);
+
+    if (parent->child == NULL)
+        parent->child = child;
+    else
+        _splice(parent->child, child);
+
+    child->parent = parent;
+    child->mark = 0;
+    parent->degree++;
+}
+
+/**
+ * \brief Cut a node out of its parent's children and add it to the root list.
+ *
+ * \param [in] fh Heap containing the node.
+ * \param [in] fe Node to cut; must not be a root.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+static void _cut(struct fibheap *fh, struct fibheap_elem *fe)
+{
+    struct fibheap_elem *parent = fe->parent;
+
+    assert(parent != NULL);
+
+    if (fe->right == fe)
+        parent->child = NULL;
+    else if (parent->child == fe)
+        parent->child = fe->right;
+    parent->degree--;
+
+    _unlink(fe);
+    _splice(fh->min, fe);
+    fe->parent = NULL;
+    fe->mark = 0;
+}
+
+/**
+ * \brief Cut a node, then keep cutting its ancestors that were already marked.
+ *
+ * A node that is not a root may lose one child and still be linked into its
+ * tree, at which point it is marked. If it loses a second child, it is cut as
+ * well, so that every tree stays large relative to the degree of its root.
+ *
+ * \param [in] fh Heap containing the node.
+ * \param [in] fe Node to cut; must not be a root.
+ *
+ * \note This operation has an amortized time complexity of O(1).
+ */
+static void _cascading_cut(struct fibheap *fh, struct fibheap_elem *fe)
+{
+    struct fibheap_elem *parent;
+
+    do
+    {
+        parent = fe->parent;
+        _cut(fh, fe);
+        fe = parent;
+    } while (fe->parent != NULL && fe->mark);
+
+    if (fe->parent != NULL)
+        fe->mark = 1;
+}
+
+/**
+ * \brief Link the roots of the heap until they all have different degrees.
+ *
+ * Each root is stored in a table indexed by its degree. When the slot for the
+ * degree is already taken, the two roots are linked and the result, with one
+ * more degree, is tried again. Afterwards, the root list is rebuilt from the
+ * table and the new minimum is found.
+ *
+ * \param [in] fh Heap to consolidate; the \c min pointer may be any root.
+ *
+ * \note This operation has a time complexity of O(r + log n), where \c r is
+ * the number of roots.
+ */
+static void _consolidate(struct fibheap *fh)
+{
+    struct fibheap_elem *table[FIBHEAP_MAX_DEGREE] = { NULL };
+    struct fibheap_elem *next, *x, *y, *tmp;
+    size_t nroots, d, maxdeg = 0;
+
+    /* Count the roots first, since linking removes them from the list. */
+    nroots = 1;
+    for (x = fh->min->right; x != fh->min; x = x->right)
+        nroots++;
+
+    next = fh->min;
+    while (nroots-- > 0)
+    {
+        x = next;
+        next = next->right;
+
+        for (d = x->degree; table[d] != NULL; d++)
+        {
+            y = table[d];
+            table[d] = NULL;
+            if (fh->cmp(y, x) < 0)
+            {
+                tmp = x;
+                x = y;
+                y = tmp;
+            }
+            _link(y, x);
+        }
+
+        assert(d < FIBHEAP_MAX_DEGREE);
+        table[d] = x;
+        if (d > maxdeg)
+            maxdeg = d;
+    }
+
+    /* Only the roots in the table are left, so rebuild the list from them. */
+    fh->min = NULL;
+    for (d = 0; d <= maxdeg; d++)
+    {
+        x = table[d];
+        if (x == NULL)
+            continue;
+
+        x->left = x;
+        x->right = x;
+        if (fh->min == NULL)
+        {
+            fh->min = x;
+        }
+        else
+        {
+            _splice(fh->min, x);
+            if (fh->cmp(x, fh->min) < 0)
+                fh->min = x;
+        }
+    }
+}
+
+/**
+ * \brief Initialize an element to use with a Fibonacci heap.
+ *
+ * Since individual elements contain links to other elements, they must be
+ * initialized before they are added to a heap. This function will make sure
+ * that the element is ready to be used.
+ *
+ * \param [inout] fe The element to initialize.
+ */
+void fibheap_elem_init(struct fibheap_elem *fe)
+{
+    fe->parent = NULL;
+    fe->child = NULL;
+    fe->left = fe;
+    fe->right = fe;
+    fe->degree = 0;
+    fe->mark = 0;
+}
+
+/**
+ * \brief Initialize a Fibonacci heap for use.
+ *
+ * This function prepares the heap for use. After calling this function,
+ * elements can be added to the heap. Note that the elements themselves must
+ * also be initialized before they can be added.
+ *
+ * \param [inout] fh The heap to initialize.
+ * \param [in] cmp Function for comparing two elements on the heap. This
+ * function takes as arguments two \c fibheap_elem structures, and returns an
+ * integer less than, equal to, or greater than zero if the first element is
+ * respectively less than, equal to, or greater than the second element.
+ */
+void fibheap_init(struct fibheap *fh, cmp_func cmp)
+{
+    fh->min = NULL;
+    fh->len = 0;
+    fh->cmp = cmp;
+}
+
+/**
+ * \brief Get the minimum element from the heap without removing it.
+ *
+ * If there are no elements on the heap, returns \c NULL. To remove the minimum
+ * element, use the #fibheap_pop() function.
+ *
+ * \param [in] fh Fibonacci heap from which to find the minimum element.
+ *
+ * \return Returns the minimum element on the heap.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+struct fibheap_elem *fibheap_peek(const struct fibheap *fh)
+{
+    return fh->min;
+}
+
+/**
+ * \brief Push a new element onto the Fibonacci heap.
+ *
+ * The element is added to the root list as a tree of its own, putting off all
+ * the work into the #fibheap_pop() function.
+ *
+ * \param [in] fh Heap onto which the new element is pushed.
+ * \param [in] fe New element to push onto the heap.
+ *
+ * \pre \p fe was initialized with #fibheap_elem_init(), or was popped or
+ * removed from a heap.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+void fibheap_push(struct fibheap *fh, struct fibheap_elem *fe)
+{
+    assert(fh != NULL);
+    assert(fe != NULL);
+    assert(fe->left == fe && fe->right == fe && fe->child == NULL);
+
+    if (fh->min == NULL)
+    {
+        fh->min = fe;
+    }
+    else
+    {
+        _splice(fh->min, fe);
+        if (fh->cmp(fe, fh->min) < 0)
+            fh->min = fe;
+    }
+
+    fh->len++;
+}
+
+/**
+ * \brief Remove the minimum element from the Fibonacci heap.
+ *
+ * The children of the minimum are moved to the root list, then the roots are
+ * consolidated so that no two have the same degree, and the smallest of them
+ * becomes the new minimum. The popped element is left ready to be pushed
+ * again.
+ *
+ * \param [in] fh Fibonacci heap from which to remove the smallest element.
+ *
+ * \return Returns the minimum element, or \c NULL if the heap is empty.
+ *
+ * \note This operation has an amortized time complexity of O(log n) with
+ * respect to the number of elements on the heap.
+ */
+struct fibheap_elem *fibheap_pop(struct fibheap *fh)
+{
+    struct fibheap_elem *ret, *c;
+
+    ret = fh->min;
+    if (ret == NULL)
+        return NULL;
+
+    /* Move the children up into the root list. */
+    c = ret->child;
+    if (c != NULL)
+    {
+        do
+        {
+            c->parent = NULL;
+            c->mark = 0;
+            c = c->right;
+        } while (c != ret->child);
+
+        _splice(ret, c);
+        ret->child = NULL;
+        ret->degree = 0;
+    }
+
+    if (ret->right == ret)
+    {
+        fh->min = NULL;
+    }
+    else
+    {
+        fh->min = ret->right;
+        _unlink(ret);
+        _consolidate(fh);
+    }
+
+    fh->len--;
+
+    return ret;
+}
+
+/**
+ * \brief Merge together two heaps.
+ *
+ * Merges all the elements from \p src into the heap \p dst by joining their
+ * root lists. After this operation, \p src will be empty and \p dst will
+ * contain all elements that were previously in either \p src and \p dst.
+ *
+ * \param [out] dst Heap into which the elements of \p src are merged.
+ * \param [in] src Heap to merge into \p dst.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+void fibheap_merge(struct fibheap *dst, struct fibheap *src)
+{
+    assert(dst->cmp == src->cmp);
+
+    if (src->min == NULL)
+        return;
+
+    if (dst->min == NULL)
+    {
+        dst->min = src->min;
+    }
+    else
+    {
+        _splice(dst->min, src->min);
+        if (dst->cmp(src->min, dst->min) < 0)
+            dst->min = src->min;
+    }
+
+    dst->len += src->len;
+    src->min = NULL;
+    src->len = 0;
+}
+
+/**
+ * \brief Restore the heap after the key of an element has been decreased.
+ *
+ * The caller first makes the element smaller in place, in its containing
+ * structure, then calls this function. If the element is now smaller than its
+ * parent, it is cut into the root list, along with any marked ancestors.
+ *
+ * \param [in] fh Fibonacci heap containing the element.
+ * \param [in] fe Element whose key was decreased.
+ *
+ * \pre \p fe is on the heap \p fh.
+ * \pre The new key of \p fe is no bigger than its old key.
+ *
+ * \note This operation has an amortized time complexity of O(1).
+ */
+void fibheap_decrease_key(struct fibheap *fh, struct fibheap_elem *fe)
+{
+    assert(fh != NULL);
+    assert(fe != NULL);
+    assert(fh->min != NULL);
+
+    if (fe->parent != NULL && fh->cmp(fe, fe->parent) < 0)
+        _cascading_cut(fh, fe);
+
+    if (fh->cmp(fe, fh->min) < 0)
+        fh->min = fe;
+}
+
+/**
+ * \brief Remove an arbitrary element from the Fibonacci heap.
+ *
+ * The element is cut into the root list, as if its key had been decreased
+ * below every other key, and then popped as the minimum. The element is left
+ * ready to be pushed again.
+ *
+ * \param [in] fh Fibonacci heap containing the element.
+ * \param [in] fe Element to remove.
+ *
+ * \pre \p fe is on the heap \p fh.
+ *
+ * \note This operation has an amortized time complexity of O(log n) with
+ * respect to the number of elements on the heap.
+ */
+void fibheap_remove(struct fibheap *fh, struct fibheap_elem *fe)
+{
+    assert(fh != NULL);
+    assert(fe != NULL);
+    assert(fh->min != NULL);
+
+    if (fe->parent != NULL)
+        _cascading_cut(fh, fe);
+
+    fh->min = fe;
+    fibheap_pop(fh);
+}
+
+/**
+ * \brief Get the number of elements on the heap.
+ *
+ * \param [in] fh Fibonacci heap to check.
+ *
+ * \return Returns the number of elements on the heap.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+size_t fibheap_len(const struct fibheap *fh)
+{
+    return fh->len;
+}
+
+/**
+ * \brief Check if the given heap is empty.
+ *
+ * \param [in] fh Fibonacci heap to check for emptiness.
+ *
+ * \return Returns 0 is there are elements on the heap. Returns nonzero if there
+ * are no elements on the heap.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+int fibheap_isempty(const struct fibheap *fh)
+{
+    return fh->min == NULL;
+}
@@ -0,0 +1,116 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file fibheap.h
+ *
+ * \brief Fibonacci heaps.
+ *
+ * A Fibonacci heap is a collection of heap-ordered trees whose roots are kept
+ * in a circular list. Pushing and merging just add trees to the root list,
+ * and decreasing a key cuts the node out of its tree, so all three take O(1)
+ * amortized time. The trees are only tidied up when the minimum is popped:
+ * trees of equal degree are linked together until every root has a different
+ * degree, which takes O(log n) amortized time. The O(1) decrease-key makes
+ * Fibonacci heaps the asymptotically best choice for Dijkstra's and Prim's
+ * algorithms on dense graphs.
+ *
+ * This implementation supports a min-heap without using any dynamic memory
+ * allocation (all memory is allocated by the caller), embedding pointers within
+ * container structures in order to simplify memory usage.
+ *
+ * Fibonacci heaps were invented by Fredman and Tarjan. For more information,
+ * see "Fibonacci Heaps and Their Uses in Improved Network Optimization
+ * Algorithms" (J. ACM 34(3), 1987).
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _FIBHEAP_H_
+#define _FIBHEAP_H_
+
+
+#include <limits.h>
+#include <stddef.h>
+
+#include "utils.h"
+
+/**
+ * \brief Upper bound on the degree of any node.
+ *
+ * A node of degree \c d has at least <tt>F(d + 2)</tt> descendants, where \c F
+ * is the Fibonacci sequence, so the degree is at most <tt>log_phi(n)</tt>. This
+ * is less than 1.5 times the number of bits in \c size_t.
+ */
+#define FIBHEAP_MAX_DEGREE  (sizeof(size_t) * CHAR_BIT * 3 / 2)
+
+/**
+ * \brief Node in a Fibonacci heap.
+ *
+ * This node element can be embedded into another structure in order to add the
+ * structure to a Fibonacci heap. Use #containerof() to get a pointer to the
+ * containing structure.
+ *
+ * Must be initialized with #fibheap_elem_init() before it is first used.
+ */
+struct fibheap_elem
+{
+    struct fibheap_elem *parent; /**< Parent of this node, or \c NULL for a
+                                      root. */
+    struct fibheap_elem *child;  /**< Any one of the children of this node. */
+    struct fibheap_elem *left;   /**< Previous sibling in a circular list. */
+    struct fibheap_elem *right;  /**< Next sibling in a circular list. */
+    size_t degree;               /**< Number of children of this node. */
+    int mark;                    /**< Set if this node has lost a child since
+                                      it last became a child itself. */
+};
+
+/**
+ * \brief Fibonacci heap structure.
+ *
+ * Must be initialized with #fibheap_init() before it can be used.
+ */
+struct fibheap
+{
+    struct fibheap_elem *min; /**< Root with the minimum element, or \c NULL
+                                   if the heap is empty. */
+    size_t len;               /**< Number of elements on the heap. */
+    cmp_func cmp;             /**< Function for comparing two elements. */
+};
+
+void fibheap_elem_init(struct fibheap_elem *fe);
+void fibheap_init(struct fibheap *fh, cmp_func cmp);
+struct fibheap_elem *fibheap_peek(const struct fibheap *fh);
+void fibheap_push(struct fibheap *fh, struct fibheap_elem *fe);
+struct fibheap_elem *fibheap_pop(struct fibheap *fh);
+void fibheap_merge(struct fibheap *dst, struct fibheap *src);
+void fibheap_decrease_key(struct fibheap *fh, struct fibheap_elem *fe);
+void fibheap_remove(struct fibheap *fh, struct fibheap_elem *fe);
+size_t fibheap_len(const struct fibheap *fh);
+int fibheap_isempty(const struct fibheap *fh);
+
+
+#endif /* end of include guard: _FIBHEAP_H_ */
@@ -0,0 +1,535 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file iheap.c
+ *
+ * \brief Indexed binary heaps with handles.
+ *
+ * The heap array holds handles rather than elements. Whenever a handle is
+ * moved in the heap array, its entry in the position map is updated to match,
+ * so the position of any element can be found in O(1) time. The handles in
+ * the heap array past the end of the heap are free; the position map is kept
+ * up to date for these too, which is why a handle can be freed or reused by
+ * just moving the end of the heap.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "iheap.h"
+#include "vector.h"
+
+/**
+ * \brief Get the handle stored at index \p i of the heap array.
+ */
+#define _handle(ih, i)  (*(size_t *)vec_get(&(ih)->heap, (i)))
+
+/**
+ * \brief Get the index of handle \p h in the heap array.
+ */
+#define _pos(ih, h)     (*(size_t *)vec_get(&(ih)->pos, (h)))
+
+/**
+ * \brief Get a pointer to the element with handle \p h.
+ */
+#define _elem(ih, h)    vec_get(&(ih)->elems, (h))
+
+/**
+ * \brief Get the index of the parent of node \p i; \p i must be positive.
+ */
+#define _parent(i)      (((i) - 1) / 2)
+
+/**
+ * \brief Get the index of the left child of node \p i.
+ */
+#define _left(i)        (2 * (i) + 1)
+
+/**
+ * \brief Store a handle at the given index of the heap array, updating the
+ * position map to match.
+ *
+ * \param [in,out] ih Pointer to the heap.
+ * \param [in] i Index in the heap array at which to store the handle.
+ * \param [in] h Handle to store.
+ */
+static void _place(struct iheap *ih, size_t i, size_t h)
+{
+    _handle(ih, i) = h;
+    _pos(ih, h) = i;
+}
+
+/**
+ * \brief Sift the element at index \p i of the heap up until its parent is no
+ * bigger than it.
+ *
+ * The handle being sifted is only stored once, at its final position; each
+ * level moves one parent down instead of swapping two handles.
+ *
+ * \param [in,out] ih Pointer to the heap to sift through.
+ * \param [in] i Index of the node to sift up.
+ *
+ * \pre <tt>i < ih->len</tt>
+ */
+static void _siftup(struct iheap *ih, size_t i)
+{
+    size_t h;
+    size_t p;
+    const void *e;
+
+    assert(i < ih->len);
+
+    h = _handle(ih, i);
+    e = _elem(ih, h);
+
+    while (i > 0)
+    {
+        p = _parent(i);
+        if (ih->cmp(e, _elem(ih, _handle(ih, p))) >= 0)
+            break;
+
+        _place(ih, i, _handle(ih, p));
+        i = p;
+    }
+
+    _place(ih, i, h);
+}
+
+/**
+ * \brief Sift the element at index \p i of the heap down until neither of its
+ * children is smaller than it.
+ *
+ * \param [in,out] ih Pointer to the heap to sift through.
+ * \param [in] i Index of the node to sift down.
+ *
+ * \pre <tt>i < ih->len</tt>
+ */
+static void _siftdown(struct iheap *ih, size_t i)
+{
+    size_t h;
+    size_t c;
+    const void *e;
+
+    assert(i < ih->len);
+
+    h = _handle(ih, i);
+    e = _elem(ih, h);
+
+    while ((c = _left(i)) < ih->len)
+    {
+        /* Use the smaller of the two children, if there are two. */
+        if (c + 1 < ih->len && ih->cmp(_elem(ih, _handle(ih, c + 1)),
+                    _elem(ih, _handle(ih, c))) < 0)
+            c++;
+
+        if (ih->cmp(_elem(ih, _handle(ih, c)), e) >= 0)
+            break;
+
+        _place(ih, i, _handle(ih, c));
+        i = c;
+    }
+
+    _place(ih, i, h);
+}
+
+/**
+ * \brief Check the heap invariant and the position map.
+ *
+ * Used only for checking postconditions in debug builds.
+ *
+ * \param [in] ih Pointer to the heap to check.
+ *
+ * \return Returns true if every element is no smaller than its parent and
+ * every handle's position is correct, or false otherwise.
+ */
+static int _checkheap(const struct iheap *ih)
+{
+    size_t i;
+    int rc = 0;
+
+    for (i = 0; i < vec_len(&ih->heap); i++)
+    {
+        if (_pos(ih, _handle(ih, i)) != i)
+            rc++;
+        if (i > 0 && i < ih->len && ih->cmp(_elem(ih, _handle(ih, _parent(i))),
+                    _elem(ih, _handle(ih, i))) > 0)
+            rc++;
+    }
+
+    return rc == 0;
+}
+
+/**
+ * \brief Initialize an indexed heap so that it is ready to be used.
+ *
+ * \param [out] ih Pointer to the heap to initialize.
+ * \param [in] cmp Function for comparing two elements of the heap.
+ * \param [in] elemsize Size of each element on the heap.
+ * \param [in] size Initial number of elements to make room for, or \c 0 for
+ *                  the default.
+ * \param [in] alloc Memory allocator used for all allocation for the heap.
+ *                   Interface should be equivalent to \c realloc.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated.
+ *
+ * \pre <tt>ih != NULL</tt>
+ * \pre <tt>cmp != NULL</tt>
+ */
+int iheap_init(struct iheap *ih, cmp_func cmp, size_t elemsize, size_t size,
+        void *(*alloc)(void *, size_t))
+{
+    assert(ih != NULL);
+    assert(cmp != NULL);
+
+    ih->cmp = cmp;
+    ih->len = 0;
+
+    if (vec_init(&ih->heap, sizeof(size_t), size, alloc) != 0)
+        return -1;
+
+    if (vec_init(&ih->pos, sizeof(size_t), size, alloc) != 0)
+    {
+        vec_destroy(&ih->heap);
+        return -1;
+    }
+
+    if (vec_init(&ih->elems, elemsize, size, alloc) != 0)
+    {
+        vec_destroy(&ih->pos);
+        vec_destroy(&ih->heap);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Free all the memory associated with the heap.
+ *
+ * \param [in,out] ih Pointer to the heap to destroy.
+ *
+ * \pre <tt>ih != NULL</tt>
+ */
+void iheap_destroy(struct iheap *ih)
+{
+    assert(ih != NULL);
+
+    vec_destroy(&ih->elems);
+    vec_destroy(&ih->pos);
+    vec_destroy(&ih->heap);
+}
+
+/**
+ * \brief Push a copy of an element onto the heap.
+ *
+ * If a handle has been freed, it is reused. Otherwise, a new handle is
+ * created, which may need more memory.
+ *
+ * \param [in,out] ih Pointer to the heap to add the element to.
+ * \param [in] e Element to copy onto the heap.
+ *
+ * \return Returns the handle of the new element, or #IHEAP_NONE if memory
+ * could not be allocated. On failure, the heap is unchanged.
+ *
+ * \pre <tt>ih != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+size_t iheap_push(struct iheap *ih, const void *e)
+{
+    size_t h;
+
+    assert(ih != NULL);
+    assert(e != NULL);
+
+    /* Take the first free handle, if there is one. Its position is already
+     * the end of the heap. */
+    if (ih->len < vec_len(&ih->heap))
+    {
+        h = _handle(ih, ih->len);
+        vec_set(&ih->elems, h, e);
+    }
+    /* Else, add a new handle at the end of all three arrays, undoing the
+     * earlier pushes if a later one fails. */
+    else
+    {
+        h = vec_len(&ih->heap);
+
+        if (vec_push(&ih->heap, &h) == -1)
+            return IHEAP_NONE;
+
+        if (vec_push(&ih->pos, &h) == -1)
+        {
+            vec_pop(&ih->heap);
+            return IHEAP_NONE;
+        }
+
+        if (vec_push(&ih->elems, e) == -1)
+        {
+            vec_pop(&ih->pos);
+            vec_pop(&ih->heap);
+            return IHEAP_NONE;
+        }
+    }
+
+    ih->len++;
+    _siftup(ih, ih->len - 1);
+
+    assert(_checkheap(ih));
+
+    return h;
+}
+
+/**
+ * \brief Remove the minimum element from the heap, freeing its handle.
+ *
+ * \param [in,out] ih Pointer to the heap to pop an element off of.
+ *
+ * \return Returns \c 0 on success, or \c -1 if the heap is empty.
+ *
+ * \pre <tt>ih != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+int iheap_pop(struct iheap *ih)
+{
+    assert(ih != NULL);
+
+    if (iheap_isempty(ih))
+        return -1;
+
+    iheap_remove(ih, _handle(ih, 0));
+
+    return 0;
+}
+
+/**
+ * \brief Get the minimum element of the heap without removing it.
+ *
+ * \param [in] ih Pointer to the heap.
+ *
+ * \return Returns a pointer to the minimum element, or \c NULL if the heap is
+ * empty.
+ *
+ * \pre <tt>ih != NULL</tt>
+ */
+void *iheap_peek(const struct iheap *ih)
+{
+    assert(ih != NULL);
+
+    if (iheap_isempty(ih))
+        return NULL;
+
+    return _elem(ih, _handle(ih, 0));
+}
+
+/**
+ * \brief Get the handle of the minimum element of the heap.
+ *
+ * \param [in] ih Pointer to the heap.
+ *
+ * \return Returns the handle of the minimum element, or #IHEAP_NONE if the
+ * heap is empty.
+ *
+ * \pre <tt>ih != NULL</tt>
+ */
+size_t iheap_peek_handle(const struct iheap *ih)
+{
+    assert(ih != NULL);
+
+    if (iheap_isempty(ih))
+        return IHEAP_NONE;
+
+    return _handle(ih, 0);
+}
+
+/**
+ * \brief Get the element with the given handle.
+ *
+ * The element must not be changed through the returned pointer in a way that
+ * changes its order, except just before calling #iheap_decrease_key() or
+ * #iheap_increase_key() on it. The pointer is invalidated by the next push.
+ *
+ * \param [in] ih Pointer to the heap.
+ * \param [in] h Handle of the element.
+ *
+ * \return Returns a pointer to the element.
+ *
+ * \pre <tt>iheap_contains(ih, h)</tt>
+ */
+void *iheap_get(const struct iheap *ih, size_t h)
+{
+    assert(iheap_contains(ih, h));
+
+    return _elem(ih, h);
+}
+
+/**
+ * \brief Determine if the given handle refers to an element on the heap.
+ *
+ * \param [in] ih Pointer to the heap.
+ * \param [in] h Handle to check.
+ *
+ * \return Returns nonzero if \p h is the handle of an element on the heap, or
+ * zero if it is free or was never given out.
+ *
+ * \pre <tt>ih != NULL</tt>
+ */
+int iheap_contains(const struct iheap *ih, size_t h)
+{
+    assert(ih != NULL);
+
+    return h < vec_len(&ih->pos) && _pos(ih, h) < ih->len;
+}
+
+/**
+ * \brief Replace an element with one that is no bigger, and restore the heap
+ * property.
+ *
+ * \param [in,out] ih Pointer to the heap.
+ * \param [in] h Handle of the element to replace.
+ * \param [in] e New value for the element. This may be the pointer returned
+ *               by #iheap_get(), if the element was changed in place.
+ *
+ * \pre <tt>iheap_contains(ih, h)</tt>
+ * \pre \p e compares less than or equal to the old value of the element.
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+void iheap_decrease_key(struct iheap *ih, size_t h, const void *e)
+{
+    assert(iheap_contains(ih, h));
+    assert(e != NULL);
+
+    if (e != _elem(ih, h))
+        vec_set(&ih->elems, h, e);
+
+    _siftup(ih, _pos(ih, h));
+
+    assert(_checkheap(ih));
+}
+
+/**
+ * \brief Replace an element with one that is no smaller, and restore the heap
+ * property.
+ *
+ * \param [in,out] ih Pointer to the heap.
+ * \param [in] h Handle of the element to replace.
+ * \param [in] e New value for the element. This may be the pointer returned
+ *               by #iheap_get(), if the element was changed in place.
+ *
+ * \pre <tt>iheap_contains(ih, h)</tt>
+ * \pre \p e compares greater than or equal to the old value of the element.
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+void iheap_increase_key(struct iheap *ih, size_t h, const void *e)
+{
+    assert(iheap_contains(ih, h));
+    assert(e != NULL);
+
+    if (e != _elem(ih, h))
+        vec_set(&ih->elems, h, e);
+
+    _siftdown(ih, _pos(ih, h));
+
+    assert(_checkheap(ih));
+}
+
+/**
+ * \brief Remove an element from the heap, freeing its handle.
+ *
+ * The last element of the heap is moved into the removed element's place,
+ * then sifted up or down as needed. The removed handle is moved to the start
+ * of the free handles, just past the end of the heap.
+ *
+ * \param [in,out] ih Pointer to the heap.
+ * \param [in] h Handle of the element to remove.
+ *
+ * \pre <tt>iheap_contains(ih, h)</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+void iheap_remove(struct iheap *ih, size_t h)
+{
+    size_t i;
+    size_t last;
+
+    assert(iheap_contains(ih, h));
+
+    i = _pos(ih, h);
+    ih->len--;
+
+    if (i != ih->len)
+    {
+        last = _handle(ih, ih->len);
+        _place(ih, i, last);
+        _place(ih, ih->len, h);
+
+        /* The moved element came from another subtree, so it may belong
+         * either above or below its new position. */
+        if (i > 0 && ih->cmp(_elem(ih, last),
+                    _elem(ih, _handle(ih, _parent(i)))) < 0)
+            _siftup(ih, i);
+        else
+            _siftdown(ih, i);
+    }
+
+    assert(_checkheap(ih));
+}
+
+/**
+ * \brief Get the number of elements on the heap.
+ *
+ * \param [in] ih Pointer to the heap.
+ *
+ * \return Returns the number of elements on the heap.
+ *
+ * \pre <tt>ih != NULL</tt>
+ */
+size_t iheap_len(const struct iheap *ih)
+{
+    assert(ih != NULL);
+
+    return ih->len;
+}
+
+/**
+ * \brief Determine if the heap is empty.
+ *
+ * \param [in] ih Pointer to the heap.
+ *
+ * \return Returns nonzero if the heap is empty, or zero otherwise.
+ *
+ * \pre <tt>ih != NULL</tt>
+ */
+int iheap_isempty(const struct iheap *ih)
+{
+    return iheap_len(ih) == 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file iheap.h
+ *
+ * \brief Indexed binary heaps with handles.
+ *
+ * An indexed heap is a binary min-heap in which every element is given a
+ * handle when it is pushed. The handle stays valid for as long as the element
+ * is on the heap, no matter how the element moves around, and can be used to
+ * look up the element, change its priority, or remove it. Each of these takes
+ * O(log n) time.
+ *
+ * The elements themselves are stored in an array indexed by handle, so they
+ * never move. The heap is an array of handles, along with a position map
+ * giving the index of each handle in the heap. Sifting only moves handles and
+ * updates the position map, no matter how large the elements are.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _IHEAP_H_
+#define _IHEAP_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils.h"
+#include "vector.h"
+
+/**
+ * \brief Handle returned by #iheap_push() when it fails.
+ */
+#define IHEAP_NONE  SIZE_MAX
+
+/**
+ * \brief Indexed binary min-heap.
+ *
+ * Handles are small integers, counting up from \c 0. When an element is
+ * popped or removed, its handle is freed and will be given out again by a
+ * later push, so a handle must not be used once its element has left the heap.
+ * Freed handles are kept at the end of the heap array, past the last element
+ * of the heap, so freeing a handle never needs any memory.
+ *
+ * Must be initialized with #iheap_init() before it can be used, and destroyed
+ * with #iheap_destroy() when it is no longer needed.
+ */
+struct iheap
+{
+    struct vector heap;  /**< Handles of the elements in heap order, followed
+                              by the free handles. */
+    struct vector pos;   /**< Index of each handle in \c heap. */
+    struct vector elems; /**< Elements of the heap, indexed by handle. */
+    size_t len;          /**< Number of elements on the heap. */
+    cmp_func cmp;        /**< Function for comparing two elements. */
+};
+
+int iheap_init(struct iheap *ih, cmp_func cmp, size_t elemsize, size_t size,
+        void *(*alloc)(void *, size_t));
+void iheap_destroy(struct iheap *ih);
+size_t iheap_push(struct iheap *ih, const void *e);
+int iheap_pop(struct iheap *ih);
+void *iheap_peek(const struct iheap *ih);
+size_t iheap_peek_handle(const struct iheap *ih);
+void *iheap_get(const struct iheap *ih, size_t h);
+int iheap_contains(const struct iheap *ih, size_t h);
+void iheap_decrease_key(struct iheap *ih, size_t h, const void *e);
+void iheap_increase_key(struct iheap *ih, size_t h, const void *e);
+void iheap_remove(struct iheap *ih, size_t h);
+size_t iheap_len(const struct iheap *ih);
+int iheap_isempty(const struct iheap *ih);
+
+
+#endif /* end of include guard: _IHEAP_H_ */
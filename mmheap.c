@@ -0,0 +1,487 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file mmheap.c
+ *
+ * \brief Double-ended priority queues using min-max heaps.
+ *
+ * The sift operations on a min-max heap work on every other level: an element
+ * moving up on a min level jumps to its grandparent, since its parent is on a
+ * max level. The min and max versions of each operation are the same apart
+ * from the direction of the comparisons, so each is written once, taking a flag
+ * that says which kind of level it is working on.
+ *
+ * As in the binary heap, elements are sifted through a hole: nodes are moved
+ * into the hole one at a time, and the sifted element is only written once it
+ * has found its place. When popping, the sifted element is the last one in the
+ * vector, which stays just past the end of the shrunken heap until the sift is
+ * done.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mmheap.h"
+#include "vector.h"
+
+/**
+ * \brief Get the index of the parent of node \p i; \p i must be positive.
+ */
+#define _parent(i)  (((i) - 1) / 2)
+
+/**
+ * \brief Get the index of the first child of node \p i.
+ */
+#define _child(i)   (2 * (i) + 1)
+
+/**
+ * \brief Determine if a node is on a max level of the heap.
+ *
+ * \param [in] i Index of the node.
+ *
+ * \return Returns nonzero if the depth of node \p i is odd.
+ */
+static int _ismax(size_t i)
+{
+    size_t depth = 0;
+
+    /* The depth is floor(log2(i + 1)). */
+#if defined(__GNUC__) && SIZE_MAX == ULONG_MAX
+    depth = sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl(i + 1);
+#else
+    for (i++; i > 1; i >>= 1)
+        depth++;
+#endif
+
+    return depth & 1;
+}
+
+/**
+ * \brief Determine if one element belongs above another on a min or max level.
+ *
+ * \param [in] mh Pointer to the heap.
+ * \param [in] a First element.
+ * \param [in] b Second element.
+ * \param [in] max Nonzero for a max level, zero for a min level.
+ *
+ * \return Returns nonzero if \p a is strictly less than \p b for a min level,
+ * or strictly greater than \p b for a max level.
+ */
+static int _before(const struct mmheap *mh, const void *a, const void *b,
+        int max)
+{
+    int c = mh->cmp(a, b);
+
+    return max ? c > 0 : c < 0;
+}
+
+/**
+ * \brief Get the index of the maximum element of a nonempty heap.
+ *
+ * \param [in] mh Pointer to the heap.
+ *
+ * \return Returns the index of the larger child of the root, or \c 0 if the
+ * root has no children.
+ */
+static size_t _maxindex(const struct mmheap *mh)
+{
+    const struct vector *v = &mh->vec;
+
+    assert(!vec_isempty(v));
+
+    if (vec_len(v) < 3)
+        return vec_len(v) - 1;
+
+    return mh->cmp(vec_get(v, 2), vec_get(v, 1)) > 0 ? 2 : 1;
+}
+
+/**
+ * \brief Sift an element up the levels of one kind, starting from a hole.
+ *
+ * \param [in,out] mh Pointer to the heap.
+ * \param [in] i Index of the hole to start from.
+ * \param [in] e Element to place in the heap; must not be stored in the heap.
+ * \param [in] max Nonzero if \p i is on a max level, zero for a min level.
+ */
+static void _bubbleup(struct mmheap *mh, size_t i, const void *e, int max)
+{
+    struct vector *v = &mh->vec;
+    size_t g;
+
+    /* Nodes 0, 1 and 2 have no grandparent. */
+    while (i > 2)
+    {
+        g = _parent(_parent(i));
+        if (!_before(mh, e, vec_get(v, g), max))
+            break;
+
+        vec_set(v, i, vec_get(v, g));
+        i = g;
+    }
+
+    vec_set(v, i, e);
+}
+
+/**
+ * \brief Sift the element just past the end of the heap down from a hole.
+ *
+ * At each step, the most extreme of the children and grandchildren of the
+ * hole is found (the smallest on a min level, or the largest on a max level).
+ * If it belongs above the sifted element, it is moved into the hole. If it was
+ * a grandchild, the sifted element may now belong above the grandchild's
+ * parent, which is on the other kind of level; if so, the two are swapped and
+ * the sift carries on with the parent's old element.
+ *
+ * \param [in,out] mh Pointer to the heap.
+ * \param [in] i Index of the hole to start from.
+ * \param [in] n Number of elements in the heap. The element to sift is stored
+ *               at index \p n of the vector.
+ * \param [in] max Nonzero if \p i is on a max level, zero for a min level.
+ *
+ * \pre <tt>i < n && n < vec_len(&mh->vec)</tt>
+ */
+static void _trickledown(struct mmheap *mh, size_t i, size_t n, int max)
+{
+    struct vector *v = &mh->vec;
+    const void *e;
+    size_t c, g, m, end;
+
+    assert(i < n && n < vec_len(v));
+
+    e = vec_get(v, n);
+
+    while ((c = _child(i)) < n)
+    {
+        /* The children are c and c + 1; the grandchildren are the four nodes
+         * starting at the first child of c. */
+        m = c;
+        if (c + 1 < n && _before(mh, vec_get(v, c + 1), vec_get(v, m), max))
+            m = c + 1;
+
+        end = _child(c) + 4;
+        if (end > n)
+            end = n;
+
+        for (g = _child(c); g < end; g++)
+        {
+            if (_before(mh, vec_get(v, g), vec_get(v, m), max))
+                m = g;
+        }
+
+        if (!_before(mh, vec_get(v, m), e, max))
+            break;
+
+        vec_set(v, i, vec_get(v, m));
+        i = m;
+
+        /* A child has no children of its own that could be more extreme, so
+         * the sifted element can stay there. */
+        if (m <= c + 1)
+            break;
+
+        if (_before(mh, vec_get(v, _parent(m)), e, max))
+            vec_swap(v, _parent(m), n);
+    }
+
+    vec_set(v, i, e);
+}
+
+/**
+ * \brief Check the min-max heap invariant.
+ *
+ * Every node is compared against its parent and its grandparent, which is
+ * enough for the invariant to hold for all descendants. Used only for checking
+ * postconditions in debug builds.
+ *
+ * \param [in] mh Pointer to the heap to check.
+ *
+ * \return Returns true if the invariant holds, or false otherwise.
+ */
+static int _checkheap(const struct mmheap *mh)
+{
+    const struct vector *v = &mh->vec;
+    size_t i, p;
+    int rc = 0;
+
+    for (i = 1; i < vec_len(v); i++)
+    {
+        p = _parent(i);
+        if (_before(mh, vec_get(v, i), vec_get(v, p), _ismax(p)))
+            rc++;
+
+        if (p > 0 && _before(mh, vec_get(v, i), vec_get(v, _parent(p)),
+                    _ismax(_parent(p))))
+            rc++;
+    }
+
+    return rc == 0;
+}
+
+/**
+ * \brief Initialize a min-max heap so that it is ready to be used.
+ *
+ * \param [out] mh Pointer to the heap to initialize.
+ * \param [in] cmp Function for comparing two elements.
+ * \param [in] elemsize Size of each element.
+ * \param [in] size Initial number of elements to make room for, or \c 0 for
+ *                  the default.
+ * \param [in] alloc Memory allocator used for all allocation for the heap.
+ *                   Interface should be equivalent to \c realloc.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated.
+ *
+ * \pre <tt>mh != NULL</tt>
+ * \pre <tt>cmp != NULL</tt>
+ */
+int mmheap_init(struct mmheap *mh, cmp_func cmp, size_t elemsize, size_t size,
+        void *(*alloc)(void *, size_t))
+{
+    assert(mh != NULL);
+    assert(cmp != NULL);
+
+    mh->cmp = cmp;
+
+    return vec_init(&mh->vec, elemsize, size, alloc);
+}
+
+/**
+ * \brief Free all the memory associated with the heap.
+ *
+ * \param [in,out] mh Pointer to the heap to destroy.
+ *
+ * \pre <tt>mh != NULL</tt>
+ */
+void mmheap_destroy(struct mmheap *mh)
+{
+    assert(mh != NULL);
+
+    vec_destroy(&mh->vec);
+}
+
+/**
+ * \brief Push a copy of an element onto the heap.
+ *
+ * The element is added at the end of the heap. If it belongs on the other kind
+ * of level than the one it was added on, it is swapped with its parent first.
+ * Then it is sifted up through the levels of that kind.
+ *
+ * \param [in,out] mh Pointer to the heap.
+ * \param [in] e Element to push.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated.
+ *
+ * \pre <tt>mh != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+int mmheap_push(struct mmheap *mh, const void *e)
+{
+    struct vector *v;
+    size_t i, p;
+    int max;
+
+    assert(mh != NULL);
+    assert(e != NULL);
+    assert(_checkheap(mh));
+
+    v = &mh->vec;
+
+    if (vec_push(v, e) == -1)
+        return -1;
+
+    i = vec_len(v) - 1;
+    if (i > 0)
+    {
+        p = _parent(i);
+        max = _ismax(i);
+
+        if (_before(mh, e, vec_get(v, p), !max))
+        {
+            vec_set(v, i, vec_get(v, p));
+            _bubbleup(mh, p, e, !max);
+        }
+        else
+        {
+            _bubbleup(mh, i, e, max);
+        }
+    }
+
+    assert(_checkheap(mh));
+
+    return 0;
+}
+
+/**
+ * \brief Remove the minimum element from the heap.
+ *
+ * \param [in,out] mh Pointer to the heap.
+ * \param [out] buf Buffer to copy the minimum element to, or \c NULL.
+ *
+ * \return Returns \c 0 on success, or \c -1 if the heap is empty.
+ *
+ * \pre <tt>mh != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+int mmheap_pop_min(struct mmheap *mh, void *buf)
+{
+    struct vector *v;
+
+    assert(mh != NULL);
+
+    v = &mh->vec;
+
+    if (vec_isempty(v))
+        return -1;
+
+    if (buf != NULL)
+        memcpy(buf, vec_head(v), v->elemsize);
+
+    if (vec_len(v) > 1)
+        _trickledown(mh, 0, vec_len(v) - 1, 0);
+    vec_pop(v);
+
+    assert(_checkheap(mh));
+
+    return 0;
+}
+
+/**
+ * \brief Remove the maximum element from the heap.
+ *
+ * \param [in,out] mh Pointer to the heap.
+ * \param [out] buf Buffer to copy the maximum element to, or \c NULL.
+ *
+ * \return Returns \c 0 on success, or \c -1 if the heap is empty.
+ *
+ * \pre <tt>mh != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(log n).
+ */
+int mmheap_pop_max(struct mmheap *mh, void *buf)
+{
+    struct vector *v;
+    size_t m;
+
+    assert(mh != NULL);
+
+    v = &mh->vec;
+
+    if (vec_isempty(v))
+        return -1;
+
+    m = _maxindex(mh);
+
+    if (buf != NULL)
+        memcpy(buf, vec_get(v, m), v->elemsize);
+
+    /* If the maximum is the last element, there is nothing to fill in. */
+    if (m < vec_len(v) - 1)
+        _trickledown(mh, m, vec_len(v) - 1, _ismax(m));
+    vec_pop(v);
+
+    assert(_checkheap(mh));
+
+    return 0;
+}
+
+/**
+ * \brief Get the minimum element of the heap without removing it.
+ *
+ * \param [in] mh Pointer to the heap.
+ *
+ * \return Returns a pointer to the minimum element, or \c NULL if the heap is
+ * empty.
+ *
+ * \pre <tt>mh != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(1).
+ */
+void *mmheap_peek_min(const struct mmheap *mh)
+{
+    assert(mh != NULL);
+
+    return vec_head(&mh->vec);
+}
+
+/**
+ * \brief Get the maximum element of the heap without removing it.
+ *
+ * \param [in] mh Pointer to the heap.
+ *
+ * \return Returns a pointer to the maximum element, or \c NULL if the heap is
+ * empty.
+ *
+ * \pre <tt>mh != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(1).
+ */
+void *mmheap_peek_max(const struct mmheap *mh)
+{
+    assert(mh != NULL);
+
+    if (vec_isempty(&mh->vec))
+        return NULL;
+
+    return vec_get(&mh->vec, _maxindex(mh));
+}
+
+/**
+ * \brief Get the number of elements on the heap.
+ *
+ * \param [in] mh Pointer to the heap.
+ *
+ * \return Returns the number of elements on the heap.
+ *
+ * \pre <tt>mh != NULL</tt>
+ */
+size_t mmheap_len(const struct mmheap *mh)
+{
+    assert(mh != NULL);
+
+    return vec_len(&mh->vec);
+}
+
+/**
+ * \brief Determine if the heap is empty.
+ *
+ * \param [in] mh Pointer to the heap.
+ *
+ * \return Returns nonzero if the heap is empty, or zero otherwise.
+ *
+ * \pre <tt>mh != NULL</tt>
+ */
+int mmheap_isempty(const struct mmheap *mh)
+{
+    return mmheap_len(mh) == 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file mmheap.h
+ *
+ * \brief Double-ended priority queues using min-max heaps.
+ *
+ * A min-max heap is a complete binary tree stored in an array, just like a
+ * binary heap, but the levels of the tree alternate between min levels and max
+ * levels. The root is on a min level. Each node on a min level is less than or
+ * equal to all of its descendants, and each node on a max level is greater than
+ * or equal to all of its descendants. So the minimum of the heap is the root,
+ * and the maximum is one of the root's children. Both can be read in O(1) time
+ * and removed in O(log n) time, using a single array of elements.
+ *
+ * Min-max heaps were invented by Atkinson, Sack, Santoro, and Strothotte. For
+ * more information, see "Min-Max Heaps and Generalized Priority Queues"
+ * (Communications of the ACM 29(10), 1986).
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _MMHEAP_H_
+#define _MMHEAP_H_
+
+
+#include "utils.h"
+#include "vector.h"
+
+/**
+ * \brief Double-ended priority queue stored in a vector.
+ *
+ * Must be initialized with #mmheap_init() before it can be used, and destroyed
+ * with #mmheap_destroy() when it is no longer needed. The vector should never
+ * be modified directly.
+ */
+struct mmheap
+{
+    struct vector vec; /**< Vector holding all the elements in the heap. */
+    cmp_func cmp;      /**< Function for comparing two elements. */
+};
+
+int mmheap_init(struct mmheap *mh, cmp_func cmp, size_t elemsize, size_t size,
+        void *(*alloc)(void *, size_t));
+void mmheap_destroy(struct mmheap *mh);
+int mmheap_push(struct mmheap *mh, const void *e);
+int mmheap_pop_min(struct mmheap *mh, void *buf);
+int mmheap_pop_max(struct mmheap *mh, void *buf);
+void *mmheap_peek_min(const struct mmheap *mh);
+void *mmheap_peek_max(const struct mmheap *mh);
+size_t mmheap_len(const struct mmheap *mh);
+int mmheap_isempty(const struct mmheap *mh);
+
+
+#endif /* end of include guard: _MMHEAP_H_ */
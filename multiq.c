@@ -0,0 +1,354 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file multiq.c
+ *
+ * \brief Relaxed concurrent priority queues made of many binary heaps.
+ *
+ * Locks are only ever taken with \c pthread_mutex_trylock() while another lock
+ * is held, so threads can never deadlock. A thread that finds a heap locked
+ * just picks another one at random, rather than waiting for it.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "binheap.h"
+#include "multiq.h"
+
+/**
+ * \brief Get a pointer to heap \p i of the MultiQueue.
+ */
+#define _heap(mq, i) \
+    ((struct multiq_heap *)((mq)->heaps + (i) * (mq)->stride))
+
+/**
+ * \brief Pick a random number below \p n.
+ *
+ * Uses the xorshift64* generator, which is fast and good enough for spreading
+ * elements over the heaps.
+ *
+ * \param [in,out] seed Random state, updated on each call.
+ * \param [in] n Upper bound on the random number.
+ *
+ * \return Returns a random number in <tt>[0, n)</tt>.
+ */
+static size_t _random(uint64_t *seed, size_t n)
+{
+    uint64_t x = *seed;
+
+    /* Zero would stay zero forever, so replace it with something else. */
+    if (x == 0)
+        x = 0x9e3779b97f4a7c15ULL;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *seed = x;
+
+    /* The high bits of the product are the most random. */
+    return (size_t)((x * 0x2545f4914f6cdd1dULL) >> 32) % n;
+}
+
+/**
+ * \brief Pick whichever of two locked heaps has the smaller minimum.
+ *
+ * \param [in] a First heap.
+ * \param [in] b Second heap, or \c NULL if there is only one.
+ *
+ * \return Returns the heap with the smaller minimum, or \c NULL if both heaps
+ * are empty.
+ */
+static struct multiq_heap *_better(struct multiq_heap *a,
+        struct multiq_heap *b)
+{
+    if (b == NULL || binheap_isempty(&b->heap))
+        return binheap_isempty(&a->heap) ? NULL : a;
+
+    if (binheap_isempty(&a->heap))
+        return b;
+
+    return a->heap.cmp(binheap_peek(&b->heap), binheap_peek(&a->heap)) < 0
+        ? b : a;
+}
+
+/**
+ * \brief Initialize a MultiQueue so that it is ready to be used.
+ *
+ * A good choice for the number of heaps is two to four times the number of
+ * threads using the queue. More heaps mean less contention, but a more relaxed
+ * order.
+ *
+ * \param [out] mq Pointer to the MultiQueue to initialize.
+ * \param [in] cmp Function for comparing two elements.
+ * \param [in] elemsize Size of each element.
+ * \param [in] nheaps Number of heaps to spread the elements over.
+ * \param [in] alloc Memory allocator used for all allocation. Interface
+ *                   should be equivalent to \c realloc, and it must be safe
+ *                   to call from several threads at once.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated
+ * or a lock could not be created.
+ *
+ * \pre <tt>mq != NULL</tt>
+ * \pre <tt>cmp != NULL</tt>
+ * \pre <tt>nheaps > 0</tt>
+ */
+int multiq_init(struct multiq *mq, cmp_func cmp, size_t elemsize,
+        size_t nheaps, void *(*alloc)(void *, size_t))
+{
+    struct multiq_heap *h;
+    size_t i;
+
+    assert(mq != NULL);
+    assert(cmp != NULL);
+    assert(nheaps > 0);
+    assert(alloc != NULL);
+
+    /* Round each heap up to a whole number of cache lines, then align the
+     * first one. */
+    mq->stride = (sizeof(struct multiq_heap) + MULTIQ_CACHE_LINE - 1)
+        / MULTIQ_CACHE_LINE * MULTIQ_CACHE_LINE;
+    mq->nheaps = nheaps;
+    mq->realloc = alloc;
+
+    mq->mem = alloc(NULL, nheaps * mq->stride + MULTIQ_CACHE_LINE - 1);
+    if (mq->mem == NULL)
+        return -1;
+
+    mq->heaps = (char *)(((uintptr_t)mq->mem + MULTIQ_CACHE_LINE - 1)
+            & ~(uintptr_t)(MULTIQ_CACHE_LINE - 1));
+
+    for (i = 0; i < nheaps; i++)
+    {
+        h = _heap(mq, i);
+
+        if (pthread_mutex_init(&h->lock, NULL) != 0)
+            break;
+
+        if (binheap_init(&h->heap, cmp, elemsize, 0, alloc) != 0)
+        {
+            pthread_mutex_destroy(&h->lock);
+            break;
+        }
+    }
+
+    /* If any heap failed, undo the ones that were set up. */
+    if (i < nheaps)
+    {
+        mq->nheaps = i;
+        multiq_destroy(mq);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Free all the memory associated with the MultiQueue.
+ *
+ * No other thread may be using the queue.
+ *
+ * \param [in,out] mq Pointer to the MultiQueue to destroy.
+ *
+ * \pre <tt>mq != NULL</tt>
+ */
+void multiq_destroy(struct multiq *mq)
+{
+    struct multiq_heap *h;
+    size_t i;
+
+    assert(mq != NULL);
+
+    for (i = 0; i < mq->nheaps; i++)
+    {
+        h = _heap(mq, i);
+        binheap_destroy(&h->heap);
+        pthread_mutex_destroy(&h->lock);
+    }
+
+    mq->realloc(mq->mem, 0);
+}
+
+/**
+ * \brief Push a copy of an element onto the MultiQueue.
+ *
+ * The element is added to a random heap that is not locked by another
+ * thread. If #MULTIQ_PUSH_TRIES random heaps are all locked, the last one is
+ * waited for, so a push always makes progress.
+ *
+ * \param [in,out] mq Pointer to the MultiQueue.
+ * \param [in] e Element to push.
+ * \param [in,out] seed Random state of the calling thread. Each thread should
+ *                      have its own, seeded with a different value.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated.
+ *
+ * \pre <tt>mq != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ * \pre <tt>seed != NULL</tt>
+ */
+int multiq_push(struct multiq *mq, const void *e, uint64_t *seed)
+{
+    struct multiq_heap *h;
+    size_t t;
+    int rc;
+
+    assert(mq != NULL);
+    assert(e != NULL);
+    assert(seed != NULL);
+
+    for (t = 0; ; t++)
+    {
+        h = _heap(mq, _random(seed, mq->nheaps));
+        if (pthread_mutex_trylock(&h->lock) == 0)
+            break;
+
+        /* Stop spinning under heavy contention, or when there is only one
+         * heap to pick. */
+        if (t + 1 >= MULTIQ_PUSH_TRIES)
+        {
+            pthread_mutex_lock(&h->lock);
+            break;
+        }
+    }
+
+    rc = binheap_push(&h->heap, e);
+
+    pthread_mutex_unlock(&h->lock);
+
+    return rc == -1 ? -1 : 0;
+}
+
+/**
+ * \brief Pop a small element off of the MultiQueue.
+ *
+ * Two random heaps are locked, and the smaller of their minimums is popped. If
+ * both are empty or either is locked by another thread, another pair is
+ * tried. After #MULTIQ_POP_TRIES pairs, every heap is checked in turn, waiting
+ * for each lock, so an element is always found if the queue is not empty.
+ *
+ * \param [in,out] mq Pointer to the MultiQueue.
+ * \param [out] buf Buffer to copy the popped element to.
+ * \param [in,out] seed Random state of the calling thread.
+ *
+ * \return Returns \c 0 if an element was popped, or \c -1 if every heap was
+ * empty.
+ *
+ * \pre <tt>mq != NULL</tt>
+ * \pre <tt>buf != NULL</tt>
+ * \pre <tt>seed != NULL</tt>
+ */
+int multiq_pop(struct multiq *mq, void *buf, uint64_t *seed)
+{
+    struct multiq_heap *a, *b, *h;
+    size_t i, t;
+
+    assert(mq != NULL);
+    assert(buf != NULL);
+    assert(seed != NULL);
+
+    for (t = 0; t < MULTIQ_POP_TRIES; t++)
+    {
+        a = _heap(mq, _random(seed, mq->nheaps));
+        b = _heap(mq, _random(seed, mq->nheaps));
+
+        if (pthread_mutex_trylock(&a->lock) != 0)
+            continue;
+
+        /* Settle for a single heap if the other one is busy. */
+        if (b == a || pthread_mutex_trylock(&b->lock) != 0)
+            b = NULL;
+
+        h = _better(a, b);
+        if (h != NULL)
+            binheap_pop_into(&h->heap, buf);
+
+        if (b != NULL)
+            pthread_mutex_unlock(&b->lock);
+        pthread_mutex_unlock(&a->lock);
+
+        if (h != NULL)
+            return 0;
+    }
+
+    /* Start the scan at a random heap, so that threads do not all pile up on
+     * the first one. */
+    i = _random(seed, mq->nheaps);
+    for (t = 0; t < mq->nheaps; t++)
+    {
+        h = _heap(mq, (i + t) % mq->nheaps);
+
+        pthread_mutex_lock(&h->lock);
+        if (binheap_pop_into(&h->heap, buf) == 0)
+        {
+            pthread_mutex_unlock(&h->lock);
+            return 0;
+        }
+        pthread_mutex_unlock(&h->lock);
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Count the elements in the MultiQueue.
+ *
+ * The heaps are counted one at a time, so if other threads are changing the
+ * queue, the result is only approximate.
+ *
+ * \param [in] mq Pointer to the MultiQueue.
+ *
+ * \return Returns the number of elements in all the heaps.
+ *
+ * \pre <tt>mq != NULL</tt>
+ */
+size_t multiq_len(struct multiq *mq)
+{
+    struct multiq_heap *h;
+    size_t len = 0;
+    size_t i;
+
+    assert(mq != NULL);
+
+    for (i = 0; i < mq->nheaps; i++)
+    {
+        h = _heap(mq, i);
+
+        pthread_mutex_lock(&h->lock);
+        len += binheap_len(&h->heap);
+        pthread_mutex_unlock(&h->lock);
+    }
+
+    return len;
+}
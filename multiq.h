@@ -0,0 +1,119 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file multiq.h
+ *
+ * \brief Relaxed concurrent priority queues made of many binary heaps.
+ *
+ * A MultiQueue spreads the elements of a priority queue over many independent
+ * binary heaps, each protected by its own lock. Pushing adds the element to a
+ * random heap. Popping looks at the minimum of two random heaps and removes
+ * the smaller of the two. With several heaps per thread, threads rarely
+ * contend for the same lock, so throughput keeps growing with the number of
+ * threads, where a single heap behind a mutex would serialize them all.
+ *
+ * The price is that the queue is relaxed: a pop returns a small element, but
+ * not necessarily the smallest one. On average, the rank of the popped element
+ * is proportional to the number of heaps. This is usually fine for scheduling
+ * work, where the exact order does not matter much.
+ *
+ * Each thread passes its own random state to the push and pop functions, so
+ * no state is shared between threads except for the heaps themselves.
+ *
+ * MultiQueues were introduced by Rihani, Sanders, and Dementiev, in
+ * "MultiQueues: Simple Relaxed Concurrent Priority Queues" (SPAA 2015).
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _MULTIQ_H_
+#define _MULTIQ_H_
+
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "binheap.h"
+#include "utils.h"
+
+/**
+ * \brief Size of a cache line, in bytes.
+ *
+ * Each heap and its lock are placed on their own cache lines, so that threads
+ * working on different heaps do not slow each other down.
+ */
+#define MULTIQ_CACHE_LINE   64
+
+/**
+ * \brief Number of random pairs of heaps tried by #multiq_pop() before it
+ * falls back to checking every heap.
+ */
+#define MULTIQ_POP_TRIES    8
+
+/**
+ * \brief Number of random heaps tried by #multiq_push() before it waits for
+ * the lock of the last one.
+ */
+#define MULTIQ_PUSH_TRIES   8
+
+/**
+ * \brief A single heap of a MultiQueue, along with its lock.
+ */
+struct multiq_heap
+{
+    pthread_mutex_t lock; /**< Lock protecting \c heap. */
+    struct binheap heap;  /**< Elements stored in this heap. */
+};
+
+/**
+ * \brief Relaxed concurrent priority queue.
+ *
+ * Must be initialized with #multiq_init() before it can be used, and destroyed
+ * with #multiq_destroy() when it is no longer needed. All other functions may
+ * be called from any number of threads at once.
+ */
+struct multiq
+{
+    char *mem;                        /**< Memory allocated for the heaps. */
+    char *heaps;                      /**< First heap, aligned to
+                                           #MULTIQ_CACHE_LINE. */
+    size_t stride;                    /**< Distance between two heaps, in
+                                           bytes. */
+    size_t nheaps;                    /**< Number of heaps. */
+    void *(*realloc)(void *, size_t); /**< Allocator for the heap array. */
+};
+
+int multiq_init(struct multiq *mq, cmp_func cmp, size_t elemsize,
+        size_t nheaps, void *(*alloc)(void *, size_t));
+void multiq_destroy(struct multiq *mq);
+int multiq_push(struct multiq *mq, const void *e, uint64_t *seed);
+int multiq_pop(struct multiq *mq, void *buf, uint64_t *seed);
+size_t multiq_len(struct multiq *mq);
+
+
+#endif /* end of include guard: _MULTIQ_H_ */
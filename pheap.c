@@ -49,7 +49,6 @@
 
 #include <assert.h>
 
-#include "list.h"
 #include "pheap.h"
 #include "utils.h"
 
@@ -58,9 +57,10 @@
  *
  * Takes two nodes in a pairing heap and merges them together, maintaining the
  * heap property. To do this, the minimum of the two nodes is set as the root,
- * and the other is merged into its children. When this operation is done, the
+ * and the other is made its first child. When this operation is done, the
  * returned node is the only one of the parameters that should be manipulated
- * further.
+ * further. The sibling links of both nodes are overwritten, so neither may be
+ * in a list of siblings.
  *
  * \param [in] ph The heap containing \p pe0 and \p pe1.
  * \param [in] pe0 The first pairing element to merge.
@@ -78,7 +78,7 @@
 static struct pheap_elem *_merge(const struct pheap *ph, struct pheap_elem *pe0,
         struct pheap_elem *pe1)
 {
-    struct pheap_elem *ret;
+    struct pheap_elem *parent, *child;
 
     assert(ph != NULL);
     assert(pe0 != NULL);
@@ -86,111 +86,126 @@ static struct pheap_elem *_merge(const struct pheap *ph, struct pheap_elem *pe0,
 
     if (ph->cmp(pe0, pe1) < 0)
     {
-        list_pushfront(&pe0->children, &pe1->child_le);
-        ret = pe0;
+        parent = pe0;
+        child = pe1;
     }
     else
     {
-        list_pushfront(&pe1->children, &pe0->child_le);
-        ret = pe1;
+        parent = pe1;
+        child = pe0;
     }
 
-    return ret;
+    /* Push the child onto the front of the parent's list of children. The
+     * first child points back at its parent. */
+    child->next = parent->child;
+    if (child->next != NULL)
+        child->next->prev = child;
+    child->prev = parent;
+    parent->child = child;
+
+    parent->next = NULL;
+    parent->prev = NULL;
+
+    return parent;
 }
 
 /**
- * \brief Merge pairs of nodes and reverse the order.
+ * \brief Cut a node out of its parent's list of children.
  *
- * Given a list of \p src nodes, merge adjacent pairs and reverse the ordering
- * of the result. The resulting merged nodes are stored in \p dst. This is the
- * first merge pass when deleting the minimum node from the heap.
+ * The node keeps its own children, so it becomes the root of a separate heap.
  *
- * \param [in] ph Pairing heap containing the nodes to merge.
- * \param [out] dst List into which the nodes are merged.
- * \param [in] src List from which to merge nodes.
- *
- * \post \c list_isempty(src)
- *
- * \note This operation has a time complexity of O(n) with respect to the length
- * of \p src.
+ * \param [in] pe The node to cut; must not be the root of the heap.
  */
-static void _merge_pairs_reverse(const struct pheap *ph, struct list *dst,
-        struct list *src)
+static void _cut(struct pheap_elem *pe)
 {
-    struct pheap_elem *left, *right;
+    assert(pe->prev != NULL);
 
-    /* Move left to right, merging pairs */
-    while (!list_isempty(src))
-    {
-        left = containerof(list_popfront(src),
-                struct pheap_elem, child_le);
-        if (!list_isempty(src))
-        {
-            right = containerof(list_popfront(src),
-                    struct pheap_elem, child_le);
-            left = _merge(ph, left, right);
-        }
+    /* The first child is linked from its parent, and the others from their
+     * previous sibling. */
+    if (pe->prev->child == pe)
+        pe->prev->child = pe->next;
+    else
+        pe->prev->next = pe->next;
 
-        /* Push the merged element onto the front of the destination, so that
-         * the result is in reverse order.
-         */
-        list_pushfront(dst, &left->child_le);
-    }
+    if (pe->next != NULL)
+        pe->next->prev = pe->prev;
+
+    pe->next = NULL;
+    pe->prev = NULL;
 }
 
 /**
- * \brief Merge a list of nodes into a single node.
+ * \brief Merge a list of siblings into a single heap.
  *
- * Given a list of \p src nodes, merge them all together to extract the minimum
- * node in the list. This function is the second merge pass when deleting the
- * minimum node in the tree; the result of this function will be the new root of
- * the heap.
+ * This is the standard two-pass pairing. The first pass merges adjacent pairs
+ * from left to right, pushing each result onto a stack (linked through the \c
+ * next pointers), which reverses their order. The second pass pops the stack,
+ * merging everything into a single node, so it runs from right to left.
  *
- * \param [in] ph Heap containing the list of nodes.
- * \param [in] src List of nodes to merge together.
+ * \param [in] ph Heap containing the nodes.
+ * \param [in] first First node in the list of siblings, or \c NULL.
  *
- * \return Returns the new root of the list.
+ * \return Returns the root of the merged heap, or \c NULL if the list is
+ * empty.
  *
- * \post \c list_isempty(src)
- *
- * \note This function has a time complexity of O(n) with respect to the length
- * of the list \p src.
+ * \note This operation has a time complexity of O(n) with respect to the number
+ * of siblings.
  */
-static struct pheap_elem *_accumulate(const struct pheap *ph, struct list *src)
+static struct pheap_elem *_combine(const struct pheap *ph,
+        struct pheap_elem *first)
 {
-    struct pheap_elem *ret;
-    struct pheap_elem *front;
+    struct pheap_elem *stack = NULL;
+    struct pheap_elem *left, *right, *ret;
 
-    if (list_isempty(src))
-    {
-        ret = NULL;
-    }
-    else
+    /* Reduce the number of nodes to handle by a factor of 2. This is what
+     * gives us the amortized O(log n) time for the structure. */
+    while (first != NULL)
     {
-        ret = containerof(list_popfront(src), struct pheap_elem, child_le);
+        left = first;
+        right = left->next;
+        first = right != NULL ? right->next : NULL;
+
+        if (right != NULL)
+            left = _merge(ph, left, right);
+
+        left->next = stack;
+        stack = left;
     }
 
-    while (!list_isempty(src))
+    if (stack == NULL)
+        return NULL;
+
+    /* Now merge all the nodes into a single node, giving us the root of the
+     * new heap. */
+    ret = stack;
+    stack = stack->next;
+    while (stack != NULL)
     {
-        front = containerof(list_popfront(src), struct pheap_elem, child_le);
-        ret = _merge(ph, ret, front);
+        right = stack->next;
+        ret = _merge(ph, ret, stack);
+        stack = right;
     }
 
+    ret->next = NULL;
+    ret->prev = NULL;
+
     return ret;
 }
 
 /**
  * \brief Initialize an element to use with a pairing heap.
  *
- * Since individual elements contain lists, they must be initialized before they
- * are added to a heap. This function will make sure that the element is ready
- * to be used.
+ * Since individual elements contain links to other elements, they must be
+ * initialized before they are added to a heap. This function will make sure
+ * that the element is ready to be used.
  *
  * \param [inout] pe The element to initialize.
  */
 void pheap_elem_init(struct pheap_elem *pe)
 {
-    list_init(&pe->children);
+    pe->child = NULL;
+    pe->next = NULL;
+    pe->prev = NULL;
 }
 
 /**
@@ -273,35 +288,94 @@ void pheap_push(struct pheap *ph, struct pheap_elem *pe)
  */
 struct pheap_elem *pheap_pop(struct pheap *ph)
 {
-    struct list merged;
     struct pheap_elem *ret;
 
     ret = ph->root;
 
-    /* If the heap is empty, then we have nothing to do. */
+    /* If the heap is empty, then we have nothing to do. Otherwise, detach the
+     * children so the popped element can be pushed again. */
     if (!pheap_isempty(ph))
     {
-        list_init(&merged);
-
-        /* Reduce the number of nodes to handle by a factor of 2. This is what
-         * gives us the amortized O(log n) time for the structure. If the root
-         * has any remaining children after this then we leaked a reference to a
-         * node.
-         */
-        _merge_pairs_reverse(ph, &merged, &ph->root->children);
-        assert(list_isempty(&ph->root->children));
-
-        /* Now merge all the nodes into a single node, giving us the new root of
-         * the heap. If the merged list has any nodes after this operation, then
-         * we leaked a reference to a node.
-         */
-        ph->root = _accumulate(ph, &merged);
-        assert(list_isempty(&merged));
+        ph->root = _combine(ph, ret->child);
+        ret->child = NULL;
     }
 
     return ret;
 }
 
+/**
+ * \brief Restore the heap after the key of an element has been decreased.
+ *
+ * The caller first makes the element smaller in place, in its containing
+ * structure, then calls this function. Unless the element is the root, the
+ * subtree rooted at the element is cut out of its parent's list of children
+ * and merged with the root. The element's own children are all still at least
+ * as big as it, so the subtree is still a valid heap.
+ *
+ * The first child of a node links back to its parent, and every other child
+ * links back to its previous sibling, so the subtree can be cut out in O(1).
+ *
+ * \param [in] ph Pairing heap containing the element.
+ * \param [in] pe Element whose key was decreased.
+ *
+ * \pre \p pe is on the heap \p ph.
+ * \pre The new key of \p pe is no bigger than its old key.
+ *
+ * \note This operation has a time-complexity of O(1). Its amortized cost is
+ * at most O(log n), and is conjectured to be O(log log n).
+ */
+void pheap_decrease_key(struct pheap *ph, struct pheap_elem *pe)
+{
+    assert(ph != NULL);
+    assert(pe != NULL);
+    assert(!pheap_isempty(ph));
+
+    if (pe != ph->root)
+    {
+        _cut(pe);
+        ph->root = _merge(ph, ph->root, pe);
+    }
+}
+
+/**
+ * \brief Remove an arbitrary element from the pairing heap.
+ *
+ * If the element is the root, this is the same as #pheap_pop(). Otherwise, the
+ * subtree rooted at the element is cut out of its parent's list of children.
+ * Then the element's children are merged into a single heap, just as when
+ * popping, and that heap is merged with the root.
+ *
+ * \param [in] ph Pairing heap containing the element.
+ * \param [in] pe Element to remove.
+ *
+ * \pre \p pe is on the heap \p ph.
+ *
+ * \note This operation has an amortized time-complexity of O(log n) with
+ * respect to the number of elements on the heap.
+ */
+void pheap_remove(struct pheap *ph, struct pheap_elem *pe)
+{
+    struct pheap_elem *sub;
+
+    assert(ph != NULL);
+    assert(pe != NULL);
+    assert(!pheap_isempty(ph));
+
+    if (pe == ph->root)
+    {
+        pheap_pop(ph);
+    }
+    else
+    {
+        _cut(pe);
+
+        sub = _combine(ph, pe->child);
+        pe->child = NULL;
+        if (sub != NULL)
+            ph->root = _merge(ph, ph->root, sub);
+    }
+}
+
 /**
  * \brief Merge together two heaps.
  *
@@ -51,7 +51,6 @@
 #define _PHEAP_H_
 
 
-#include "list.h"
 #include "utils.h"
 
 /**
@@ -61,14 +60,20 @@
  * structure to a pairing heap. Use #containerof() to get a pointer to the
  * containing structure.
  *
+ * The children of a node are kept in a doubly-linked list of siblings, using
+ * the left-child, right-sibling layout. To keep the node small, the list has no
+ * header: the first child's \c prev pointer points to its parent instead of to
+ * a previous sibling. This is three pointers per node.
+ *
  * Must be initialized with #pheap_elem_init() before it can be pushed onto a
  * heap.
  */
 struct pheap_elem
 {
-    struct list children;      /**< List of children of this node. */
-    struct list_elem child_le; /**< List element to add this node to its
-                                    parent's list. */
+    struct pheap_elem *child; /**< First child of this node. */
+    struct pheap_elem *next;  /**< Next sibling of this node. */
+    struct pheap_elem *prev;  /**< Previous sibling of this node, or its
+                                   parent if this is the first child. */
 };
 
 /**
@@ -93,6 +98,8 @@ void pheap_init(struct pheap *ph, cmp_func cmp);
 struct pheap_elem *pheap_peek(const struct pheap *ph);
 void pheap_push(struct pheap *ph, struct pheap_elem *pe);
 struct pheap_elem *pheap_pop(struct pheap *ph);
+void pheap_decrease_key(struct pheap *ph, struct pheap_elem *pe);
+void pheap_remove(struct pheap *ph, struct pheap_elem *pe);
 void pheap_merge(struct pheap *dst, struct pheap *src);
 int pheap_isempty(struct pheap *ph);
 
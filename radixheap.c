@@ -0,0 +1,360 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file radixheap.c
+ *
+ * \brief Radix heaps for monotone integer priorities.
+ *
+ * Bucket \c 0 always holds keys equal to #radixheap::last, so popping from it
+ * is trivial. When it runs out, the lowest nonempty bucket is searched for its
+ * smallest key, which becomes the new last key, and the rest of that bucket
+ * is spread over the buckets below it. Since every key in the bucket agrees
+ * with the new last key on all bits above the bucket's bit, each key lands in
+ * a strictly lower bucket.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "radixheap.h"
+#include "vector.h"
+
+/**
+ * \brief Get the bucket for a key, relative to the last key popped.
+ *
+ * \param [in] last Last key popped from the heap.
+ * \param [in] key Key to find the bucket of.
+ *
+ * \return Returns \c 0 if the keys are equal, or one more than the index of the
+ * highest bit in which they differ otherwise.
+ *
+ * \pre <tt>key >= last</tt>
+ */
+static size_t _bucket(uint64_t last, uint64_t key)
+{
+    uint64_t x = key ^ last;
+
+    assert(key >= last);
+
+    if (x == 0)
+        return 0;
+
+#if defined(__GNUC__) && ULLONG_MAX == UINT64_MAX
+    return 64 - __builtin_clzll(x);
+#else
+    {
+        size_t ret = 0;
+
+        while (x != 0)
+        {
+            x >>= 1;
+            ret++;
+        }
+
+        return ret;
+    }
+#endif
+}
+
+/**
+ * \brief Refill bucket \c 0 from the lowest nonempty bucket.
+ *
+ * Space for the moved elements is reserved in every target bucket before any
+ * element is moved, so if an allocation fails the heap is left unchanged.
+ *
+ * \param [in,out] rh Pointer to the heap.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated.
+ *
+ * \pre The heap is not empty, and bucket \c 0 is empty.
+ */
+static int _refill(struct radixheap *rh)
+{
+    size_t counts[RADIXHEAP_BUCKETS];
+    const uint64_t *keys;
+    uint64_t min;
+    size_t i, j, b, n;
+
+    assert(rh->len > 0);
+    assert(vec_isempty(&rh->keys[0]));
+
+    for (i = 1; vec_isempty(&rh->keys[i]); i++)
+        assert(i + 1 < RADIXHEAP_BUCKETS);
+
+    keys = vec_head(&rh->keys[i]);
+    n = vec_len(&rh->keys[i]);
+
+    min = keys[0];
+    for (j = 1; j < n; j++)
+    {
+        if (keys[j] < min)
+            min = keys[j];
+    }
+
+    /* Count how many elements go to each bucket, and make room for them. */
+    memset(counts, 0, sizeof(counts));
+    for (j = 0; j < n; j++)
+        counts[_bucket(min, keys[j])]++;
+
+    for (b = 0; b < i; b++)
+    {
+        if (counts[b] == 0)
+            continue;
+
+        if (vec_reserve(&rh->keys[b], vec_len(&rh->keys[b]) + counts[b]) != 0
+                || vec_reserve(&rh->vals[b],
+                    vec_len(&rh->vals[b]) + counts[b]) != 0)
+            return -1;
+    }
+
+    /* Now nothing can fail, so move the elements down. */
+    for (j = 0; j < n; j++)
+    {
+        b = _bucket(min, keys[j]);
+        vec_push(&rh->keys[b], &keys[j]);
+        vec_push(&rh->vals[b], vec_get(&rh->vals[i], j));
+    }
+
+    vec_erase_range(&rh->keys[i], 0, n);
+    vec_erase_range(&rh->vals[i], 0, n);
+    rh->last = min;
+
+    return 0;
+}
+
+/**
+ * \brief Initialize a radix heap so that it is ready to be used.
+ *
+ * \param [out] rh Pointer to the heap to initialize.
+ * \param [in] elemsize Size of the payload stored with each key.
+ * \param [in] alloc Memory allocator used for all allocation for the heap.
+ *                   Interface should be equivalent to \c realloc.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated.
+ *
+ * \pre <tt>rh != NULL</tt>
+ * \pre <tt>elemsize > 0</tt>
+ */
+int radixheap_init(struct radixheap *rh, size_t elemsize,
+        void *(*alloc)(void *, size_t))
+{
+    size_t i;
+
+    assert(rh != NULL);
+    assert(elemsize > 0);
+
+    rh->last = 0;
+    rh->len = 0;
+
+    /* Most buckets are rarely used, so start them all small. */
+    for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+        if (vec_init(&rh->keys[i], sizeof(uint64_t), 1, alloc) != 0)
+            break;
+
+        if (vec_init(&rh->vals[i], elemsize, 1, alloc) != 0)
+        {
+            vec_destroy(&rh->keys[i]);
+            break;
+        }
+    }
+
+    if (i < RADIXHEAP_BUCKETS)
+    {
+        while (i-- > 0)
+        {
+            vec_destroy(&rh->vals[i]);
+            vec_destroy(&rh->keys[i]);
+        }
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Free all the memory associated with the heap.
+ *
+ * \param [in,out] rh Pointer to the heap to destroy.
+ *
+ * \pre <tt>rh != NULL</tt>
+ */
+void radixheap_destroy(struct radixheap *rh)
+{
+    size_t i;
+
+    assert(rh != NULL);
+
+    for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+        vec_destroy(&rh->vals[i]);
+        vec_destroy(&rh->keys[i]);
+    }
+}
+
+/**
+ * \brief Push an element onto the heap.
+ *
+ * \param [in,out] rh Pointer to the heap.
+ * \param [in] key Key of the new element.
+ * \param [in] e Payload to copy onto the heap with the key.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated,
+ * in which case the heap is unchanged.
+ *
+ * \pre <tt>rh != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ * \pre \p key is no smaller than the last key popped.
+ *
+ * \note This operation takes O(1) time, not counting the allocator.
+ */
+int radixheap_push(struct radixheap *rh, uint64_t key, const void *e)
+{
+    size_t b;
+
+    assert(rh != NULL);
+    assert(e != NULL);
+    assert(key >= rh->last);
+
+    b = _bucket(rh->last, key);
+
+    if (vec_push(&rh->keys[b], &key) == -1)
+        return -1;
+
+    if (vec_push(&rh->vals[b], e) == -1)
+    {
+        vec_pop(&rh->keys[b]);
+        return -1;
+    }
+
+    rh->len++;
+
+    return 0;
+}
+
+/**
+ * \brief Remove an element with the minimum key from the heap.
+ *
+ * \param [in,out] rh Pointer to the heap.
+ * \param [out] key Where to store the key of the element, or \c NULL.
+ * \param [out] e Buffer to copy the payload of the element to, or \c NULL.
+ *
+ * \return Returns \c 0 on success. Returns \c -1 if the heap is empty, or if
+ * memory could not be allocated while splitting up a bucket; in either case
+ * the heap is unchanged.
+ *
+ * \pre <tt>rh != NULL</tt>
+ *
+ * \note This operation takes amortized O(log C) time, where \c C is the range
+ * of keys on the heap.
+ */
+int radixheap_pop(struct radixheap *rh, uint64_t *key, void *e)
+{
+    void *val;
+
+    assert(rh != NULL);
+
+    val = radixheap_peek(rh, key);
+    if (val == NULL)
+        return -1;
+
+    if (e != NULL)
+        memcpy(e, val, rh->vals[0].elemsize);
+
+    vec_pop(&rh->keys[0]);
+    vec_pop(&rh->vals[0]);
+    rh->len--;
+
+    return 0;
+}
+
+/**
+ * \brief Get an element with the minimum key, without removing it.
+ *
+ * This may need to split up a bucket, so it is not a const operation. Once it
+ * has succeeded, the next #radixheap_pop() will not need to.
+ *
+ * \param [in,out] rh Pointer to the heap.
+ * \param [out] key Where to store the key of the element, or \c NULL.
+ *
+ * \return Returns a pointer to the payload of the element. Returns \c NULL if
+ * the heap is empty, or if memory could not be allocated while splitting up a
+ * bucket.
+ *
+ * \pre <tt>rh != NULL</tt>
+ */
+void *radixheap_peek(struct radixheap *rh, uint64_t *key)
+{
+    assert(rh != NULL);
+
+    if (rh->len == 0)
+        return NULL;
+
+    if (vec_isempty(&rh->keys[0]) && _refill(rh) != 0)
+        return NULL;
+
+    if (key != NULL)
+        *key = rh->last;
+
+    return vec_tail(&rh->vals[0]);
+}
+
+/**
+ * \brief Get the number of elements on the heap.
+ *
+ * \param [in] rh Pointer to the heap.
+ *
+ * \return Returns the number of elements on the heap.
+ *
+ * \pre <tt>rh != NULL</tt>
+ */
+size_t radixheap_len(const struct radixheap *rh)
+{
+    assert(rh != NULL);
+
+    return rh->len;
+}
+
+/**
+ * \brief Determine if the heap is empty.
+ *
+ * \param [in] rh Pointer to the heap.
+ *
+ * \return Returns nonzero if the heap is empty, or zero otherwise.
+ *
+ * \pre <tt>rh != NULL</tt>
+ */
+int radixheap_isempty(const struct radixheap *rh)
+{
+    return radixheap_len(rh) == 0;
+}
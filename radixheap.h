@@ -0,0 +1,99 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file radixheap.h
+ *
+ * \brief Radix heaps for monotone integer priorities.
+ *
+ * A radix heap is a priority queue for unsigned integer keys, which requires
+ * that keys are never pushed below the last key popped. This is the case in
+ * Dijkstra's algorithm and in discrete event simulations, where time only
+ * moves forward. In exchange, the heap never compares two elements: keys are
+ * placed into buckets according to the highest bit in which they differ from
+ * the last key popped, and a bucket is only split up again when it is needed.
+ * Each element moves to a lower bucket at most once per bit of the key, so
+ * pushing and popping take amortized O(log C) time, where \c C is the range of
+ * the keys in the heap.
+ *
+ * Each element has a 64-bit key and a payload of fixed size, which is stored
+ * alongside the key.
+ *
+ * Radix heaps were invented by Ahuja, Mehlhorn, Orlin, and Tarjan. For more
+ * information, see "Faster Algorithms for the Shortest Path Problem" (J. ACM
+ * 37(2), 1990).
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _RADIXHEAP_H_
+#define _RADIXHEAP_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vector.h"
+
+/**
+ * \brief Number of buckets in a radix heap.
+ *
+ * Bucket \c 0 holds keys equal to the last key popped, and bucket \c i holds
+ * keys whose highest bit differing from the last key popped is bit <tt>i -
+ * 1</tt>.
+ */
+#define RADIXHEAP_BUCKETS   65
+
+/**
+ * \brief Radix heap with 64-bit keys.
+ *
+ * The keys and payloads of each bucket are kept in separate vectors, so that
+ * searching a bucket for its minimum key only touches the keys.
+ *
+ * Must be initialized with #radixheap_init() before it can be used, and
+ * destroyed with #radixheap_destroy() when it is no longer needed.
+ */
+struct radixheap
+{
+    struct vector keys[RADIXHEAP_BUCKETS]; /**< Keys in each bucket. */
+    struct vector vals[RADIXHEAP_BUCKETS]; /**< Payloads in each bucket, in
+                                                the same order as the keys. */
+    uint64_t last;                         /**< Last key popped; no smaller
+                                                key may be pushed. */
+    size_t len;                            /**< Number of elements. */
+};
+
+int radixheap_init(struct radixheap *rh, size_t elemsize,
+        void *(*alloc)(void *, size_t));
+void radixheap_destroy(struct radixheap *rh);
+int radixheap_push(struct radixheap *rh, uint64_t key, const void *e);
+int radixheap_pop(struct radixheap *rh, uint64_t *key, void *e);
+void *radixheap_peek(struct radixheap *rh, uint64_t *key);
+size_t radixheap_len(const struct radixheap *rh);
+int radixheap_isempty(const struct radixheap *rh);
+
+
+#endif /* end of include guard: _RADIXHEAP_H_ */
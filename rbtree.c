@@ -73,19 +73,9 @@
     assert(_is_black(tree->root));               \
     assert(_check_red_nodes(tree->root) == 0);   \
     assert(_get_black_depth(tree->root) >= 0);   \
+    assert(!tree->order || _check_sizes(tree->root) >= 0); \
 } while (0)
 
-/**
- * \brief Maximum achievable depth of a red-black tree.
- *
- * The maximum depth is determined by the memory size of the machine; this value
- * should be larger than the max possible depth of the tree, but small enough
- * that an array of this size can easily be created. The size is used to keep a
- * path from the inserted node to the root in #rbtree_insert() to avoid storing
- * parent pointers in each node.
- */
-#define MAX_RBTREE_DEPTH 128
-
 /**
  * \brief Verifies that every node is either black or red.
  *
@@ -180,15 +170,70 @@ static int _get_black_depth(const struct rbnode *node)
     return left + (_is_black(node) ? 1 : 0);
 }
 
+/**
+ * \brief Get the number of nodes in the subtree rooted at \p node.
+ *
+ * \param [in] node Root of the subtree; must be embedded in a #rbosnode unless
+ * it is \c NULL.
+ *
+ * \return Returns the size of the subtree, or 0 if \p node is \c NULL.
+ */
+static size_t _size(const struct rbnode *node)
+{
+    return node == NULL ? 0 : containerof(node, struct rbosnode, rbn)->size;
+}
+
+/**
+ * \brief Recompute the subtree size of \p node from its children.
+ *
+ * Does nothing unless \p tree keeps order statistics.
+ *
+ * \param [in] tree The red-black tree containing \p node.
+ * \param [in] node Node whose children have correct sizes.
+ */
+static void _update_size(const struct rbtree *tree, struct rbnode *node)
+{
+    if (tree->order)
+    {
+        containerof(node, struct rbosnode, rbn)->size
+            = _size(node->left) + _size(node->right) + 1;
+    }
+}
+
+/**
+ * \brief Verifies the subtree size stored in every node.
+ *
+ * \param [in] node Root node of the tree to check.
+ *
+ * \return Returns the size of the tree rooted at \p node if every stored size
+ * is correct, or -1 otherwise.
+ */
+static long _check_sizes(const struct rbnode *node)
+{
+    long left, right;
+
+    if (node == NULL)
+        return 0;
+
+    left = _check_sizes(node->left);
+    right = _check_sizes(node->right);
+
+    if (left == -1 || right == -1 || (size_t)(left + right + 1) != _size(node))
+        return -1;
+
+    return left + right + 1;
+}
+
 /**
  * \brief Perform a left (counterclockwise) rotation rooted at the given \p
  * node.
  *
+ * \param [in] tree The red-black tree, for updating subtree sizes.
  * \param [in] n The node to rotate around. This must be a pointer to the child
  * pointer stored within the tree, so that the parent's pointers can be modified
  * if needed.
  */
-static void _rotate_left(struct rbnode **n)
+static void _rotate_left(const struct rbtree *tree, struct rbnode **n)
 {
     struct rbnode *parent;
 
@@ -198,16 +243,20 @@ static void _rotate_left(struct rbnode **n)
     *n = parent->right;
     parent->right = (*n)->left;
     (*n)->left = parent;
+
+    _update_size(tree, parent);
+    _update_size(tree, *n);
 }
 
 /**
  * \brief Perform a right (clockwise) rotation rooted at the given \p node.
  *
+ * \param [in] tree The red-black tree, for updating subtree sizes.
  * \param [in] n The node to rotate around. This must be a pointer to the child
  * pointer stored within the tree, so that the parent's pointers can be modified
  * if needed.
  */
-static void _rotate_right(struct rbnode **n)
+static void _rotate_right(const struct rbtree *tree, struct rbnode **n)
 {
     struct rbnode *parent;
 
@@ -217,6 +266,9 @@ static void _rotate_right(struct rbnode **n)
     *n = parent->left;
     parent->left = (*n)->right;
     (*n)->right = parent;
+
+    _update_size(tree, parent);
+    _update_size(tree, *n);
 }
 
 /**
@@ -248,6 +300,357 @@ static int _traverse(const struct rbnode *node, RBCallback cb, void *scratch)
     return 0;
 }
 
+/**
+ * \brief Find the path from the root of the tree to the given \p node.
+ *
+ * Nodes with equal keys may end up on either side of each other after
+ * rotations, so whenever a node compares equal but is not \p node, both of its
+ * subtrees are searched: the left one first, then the right one. Without
+ * duplicates, this is a plain search down a single path.
+ *
+ * \param [in] tree Red-black tree to search for \p node.
+ * \param [in] node The node to find.
+ * \param [out] backtrace Filled with pointers to the child pointers along the
+ * path, starting at the root pointer.
+ * \param [out] current Set to the index of \p node in \p backtrace.
+ *
+ * \return Returns 0 if \p node was found, or -1 if it is not in the tree.
+ */
+static int _find_path(struct rbtree *tree, const struct rbnode *node,
+        struct rbnode **backtrace[], size_t *current)
+{
+    unsigned char equal[MAX_RBTREE_DEPTH];
+    struct rbnode *cur;
+    size_t depth;
+    int cmp;
+
+    depth = 0;
+    backtrace[depth] = &tree->root;
+
+    for (;;)
+    {
+        cur = *backtrace[depth];
+        if (cur == node)
+        {
+            *current = depth;
+            return 0;
+        }
+
+        if (cur != NULL)
+        {
+            cmp = tree->cmp(node, cur);
+
+            depth++;
+            assert(depth < MAX_RBTREE_DEPTH);
+
+            equal[depth] = cmp == 0;
+            backtrace[depth] = cmp <= 0 ? &cur->left : &cur->right;
+            continue;
+        }
+
+        /* Dead end; back up to the last node with an equal key, and search
+         * its right subtree instead. */
+        while (depth > 0 && !equal[depth])
+            depth--;
+        if (depth == 0)
+            return -1;
+
+        equal[depth] = 0;
+        backtrace[depth] = &(*backtrace[depth-1])->right;
+    }
+}
+
+/**
+ * \brief Remove the node at the end of a path from the root, then rebalance.
+ *
+ * If the node has two children, it first trades places (and colors) with its
+ * in-order successor, which has no left child. The node is then replaced by
+ * its only child. Removing a black node leaves its side of the tree one black
+ * node short; this is fixed by walking back up the path, recoloring and
+ * rotating around the sibling of the short side.
+ *
+ * For more details on the rebalancing operation, see
+ * https://en.wikipedia.org/wiki/Red-black_tree
+ *
+ * \param [in] tree The red-black tree from which the node is removed.
+ * \param [in] backtrace Pointers to the child pointers along the path from the
+ * root pointer to the node. The array must have room for #MAX_RBTREE_DEPTH
+ * entries, and is overwritten.
+ * \param [in] current Index of the node to remove in \p backtrace.
+ */
+static void _remove_at(struct rbtree *tree, struct rbnode **backtrace[],
+        size_t current)
+{
+    struct rbnode *node, *succ, *parent, *sibling, *right;
+    size_t depth, size;
+    int color;
+
+    node = *backtrace[current];
+
+    /* Swap the node with its successor, extending the path down to it. */
+    if (node->left != NULL && node->right != NULL)
+    {
+        depth = current + 1;
+        backtrace[depth] = &node->right;
+        while ((*backtrace[depth])->left != NULL)
+        {
+            backtrace[depth+1] = &(*backtrace[depth])->left;
+            depth++;
+            assert(depth + 1 < MAX_RBTREE_DEPTH);
+        }
+        succ = *backtrace[depth];
+        right = succ->right;
+
+        *backtrace[current] = succ;
+        succ->left = node->left;
+        if (depth == current + 1)
+        {
+            succ->right = node;
+        }
+        else
+        {
+            succ->right = node->right;
+            *backtrace[depth] = node;
+        }
+        node->left = NULL;
+        node->right = right;
+
+        color = succ->color;
+        succ->color = node->color;
+        node->color = color;
+
+        /* Subtree sizes belong to the positions in the tree. */
+        if (tree->order)
+        {
+            size = _size(succ);
+            containerof(succ, struct rbosnode, rbn)->size = _size(node);
+            containerof(node, struct rbosnode, rbn)->size = size;
+        }
+
+        backtrace[current+1] = &succ->right;
+        current = depth;
+    }
+
+    /* Now the node has at most one child, which takes its place. */
+    *backtrace[current] = node->left != NULL ? node->left : node->right;
+    node->left = node->right = NULL;
+
+    /* Every subtree along the path has lost a node. */
+    if (tree->order)
+    {
+        for (depth = 0; depth < current; depth++)
+            containerof(*backtrace[depth], struct rbosnode, rbn)->size--;
+    }
+
+    if (node->color == RB_RED)
+        return;
+
+    /*
+     * The subtree at backtrace[current] is now one black node short. A red
+     * node there can just be repainted black; otherwise, fix up the sibling's
+     * side or move the problem up the tree.
+     */
+    while (current > 0 && _is_black(*backtrace[current]))
+    {
+        parent = *backtrace[current-1];
+
+        if (backtrace[current] == &parent->left)
+        {
+            /* The sibling's side has at least one black node, so it must
+             * exist. */
+            sibling = parent->right;
+            assert(sibling != NULL);
+
+            /* Rotate a red sibling up, so that the new sibling is black. The
+             * parent moves one level down the path. */
+            if (!_is_black(sibling))
+            {
+                sibling->color = RB_BLACK;
+                parent->color  = RB_RED;
+                _rotate_left(tree, backtrace[current-1]);
+
+                backtrace[current] = &sibling->left;
+                backtrace[current+1] = &parent->left;
+                current++;
+                assert(current + 1 < MAX_RBTREE_DEPTH);
+
+                sibling = parent->right;
+            }
+
+            /* If the sibling has no red children, repainting it red evens out
+             * both sides, and moves the missing black node up a level. */
+            if (_is_black(sibling->left) && _is_black(sibling->right))
+            {
+                sibling->color = RB_RED;
+                current--;
+                continue;
+            }
+
+            /* Make sure the sibling's outer child is red. */
+            if (_is_black(sibling->right))
+            {
+                sibling->left->color = RB_BLACK;
+                sibling->color = RB_RED;
+                _rotate_right(tree, &parent->right);
+                sibling = parent->right;
+            }
+
+            /* Rotating the sibling up adds a black node to this side. */
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->right->color = RB_BLACK;
+            _rotate_left(tree, backtrace[current-1]);
+        }
+        else
+        {
+            assert(backtrace[current] == &parent->right);
+
+            sibling = parent->left;
+            assert(sibling != NULL);
+
+            if (!_is_black(sibling))
+            {
+                sibling->color = RB_BLACK;
+                parent->color  = RB_RED;
+                _rotate_right(tree, backtrace[current-1]);
+
+                backtrace[current] = &sibling->right;
+                backtrace[current+1] = &parent->right;
+                current++;
+                assert(current + 1 < MAX_RBTREE_DEPTH);
+
+                sibling = parent->left;
+            }
+
+            if (_is_black(sibling->left) && _is_black(sibling->right))
+            {
+                sibling->color = RB_RED;
+                current--;
+                continue;
+            }
+
+            if (_is_black(sibling->left))
+            {
+                sibling->right->color = RB_BLACK;
+                sibling->color = RB_RED;
+                _rotate_left(tree, &parent->left);
+                sibling = parent->left;
+            }
+
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->left->color = RB_BLACK;
+            _rotate_right(tree, backtrace[current-1]);
+        }
+
+        /* The tree is balanced again. Note that the backtrace is now only
+         * valid up to (including) current-1. */
+        current = 0;
+    }
+
+    /* Either a red node took the place of a black one, or the root was
+     * reached (and must be black anyway). */
+    if (*backtrace[current] != NULL)
+        (*backtrace[current])->color = RB_BLACK;
+}
+
+/**
+ * \brief Get the node the iterator points to.
+ *
+ * \param [in] it The iterator.
+ *
+ * \return Returns the current node, or \c NULL if the iterator is past either
+ * end of the tree.
+ */
+static struct rbnode *_iter_node(const struct rbiter *it)
+{
+    return it->depth > 0 ? it->path[it->depth-1] : NULL;
+}
+
+/**
+ * \brief Extend the iterator's path to the leftmost node below \p node.
+ *
+ * \param [in,out] it The iterator, whose path ends at the parent of \p node.
+ * \param [in] node Root of the subtree to descend; may be \c NULL.
+ */
+static void _push_leftmost(struct rbiter *it, struct rbnode *node)
+{
+    while (node != NULL)
+    {
+        assert(it->depth < MAX_RBTREE_DEPTH);
+        it->path[it->depth++] = node;
+        node = node->left;
+    }
+}
+
+/**
+ * \brief Extend the iterator's path to the rightmost node below \p node.
+ *
+ * \param [in,out] it The iterator, whose path ends at the parent of \p node.
+ * \param [in] node Root of the subtree to descend; may be \c NULL.
+ */
+static void _push_rightmost(struct rbiter *it, struct rbnode *node)
+{
+    while (node != NULL)
+    {
+        assert(it->depth < MAX_RBTREE_DEPTH);
+        it->path[it->depth++] = node;
+        node = node->right;
+    }
+}
+
+/**
+ * \brief Point the iterator at the first node after \p key.
+ *
+ * Searches down from the root, keeping the whole path in the iterator. The
+ * path to the answer is a prefix of the search path: it ends at the last node
+ * where the search went left.
+ *
+ * \param [in] tree The red-black tree to search.
+ * \param [in] key Key to search for.
+ * \param [out] it The iterator to set up.
+ * \param [in] strict If nonzero, find the first node greater than \p key;
+ * otherwise find the first node greater than or equal to \p key.
+ *
+ * \return Returns the node found, or \c NULL if there is no such node.
+ */
+static struct rbnode *_bound(const struct rbtree *tree,
+        const struct rbnode *key, struct rbiter *it, int strict)
+{
+    struct rbnode *cur;
+    size_t found;
+    int cmp;
+
+    assert(tree != NULL);
+    assert(key != NULL);
+    assert(it != NULL);
+
+    it->depth = 0;
+    found = 0;
+    cur = tree->root;
+
+    while (cur != NULL)
+    {
+        assert(it->depth < MAX_RBTREE_DEPTH);
+        it->path[it->depth++] = cur;
+
+        cmp = tree->cmp(key, cur);
+        if (cmp < 0 || (cmp == 0 && !strict))
+        {
+            found = it->depth;
+            cur = cur->left;
+        }
+        else
+        {
+            cur = cur->right;
+        }
+    }
+
+    it->depth = found;
+
+    return _iter_node(it);
+}
+
 /**
  * \brief Initialize the red-black tree.
  *
@@ -263,6 +666,25 @@ void rbtree_init(struct rbtree *tree, cmp_func compare)
 
     tree->root = NULL;
     tree->cmp = compare;
+    tree->order = 0;
+}
+
+/**
+ * \brief Initialize a red-black tree that keeps order statistics.
+ *
+ * Like #rbtree_init(), but every node must be embedded in a #rbosnode, which
+ * stores the size of the subtree rooted at the node. The sizes are kept up to
+ * date through insertions, removals and rotations, at a small constant cost
+ * per node on the path. In return, #rbtree_select() and #rbtree_rank() run in
+ * <tt>O(log n)</tt> time.
+ *
+ * \param [out] tree Red-black tree to initialize.
+ * \param [in] compare Function for comparing two nodes.
+ */
+void rbtree_init_os(struct rbtree *tree, cmp_func compare)
+{
+    rbtree_init(tree, compare);
+    tree->order = 1;
 }
 
 /**
@@ -341,6 +763,8 @@ void rbtree_insert(struct rbtree *tree, struct rbnode *node)
     /* Initialize the properties of the new node. */
     node->color = RB_RED;
     node->left = node->right = NULL;
+    if (tree->order)
+        containerof(node, struct rbosnode, rbn)->size = 1;
 
     current = 0;
     backtrace[current] = &tree->root;
@@ -358,6 +782,10 @@ void rbtree_insert(struct rbtree *tree, struct rbnode *node)
 
         uncles[current] = uncle;
 
+        /* The new node ends up below every node on the path. */
+        if (tree->order)
+            containerof(parent, struct rbosnode, rbn)->size++;
+
         if (tree->cmp(node, parent) < 0)
         {
             backtrace[current] = &parent->left;
@@ -433,12 +861,12 @@ void rbtree_insert(struct rbtree *tree, struct rbnode *node)
     /* If the current node is an inner child, rotate it to the outside. */
     if (node == parent->right && parent == gparent->left)
     {
-        _rotate_left(backtrace[current-1]);
+        _rotate_left(tree, backtrace[current-1]);
         parent = node;
     }
     else if (node == parent->left && parent == gparent->right)
     {
-        _rotate_right(backtrace[current-1]);
+        _rotate_right(tree, backtrace[current-1]);
         parent = node;
     }
 
@@ -455,17 +883,370 @@ void rbtree_insert(struct rbtree *tree, struct rbnode *node)
     gparent->color = RB_RED;
     if (parent == gparent->right)
     {
-        _rotate_left(backtrace[current-2]);
+        _rotate_left(tree, backtrace[current-2]);
     }
     else
     {
         assert(parent == gparent->left);
-        _rotate_right(backtrace[current-2]);
+        _rotate_right(tree, backtrace[current-2]);
     }
 
     RBCHECK(tree);
 }
 
+/**
+ * \brief Remove a node matching \p key from \p tree.
+ *
+ * Searches the tree for a node matching the \p key, just like #rbtree_search(),
+ * then removes that node and rebalances the tree. If several nodes match the
+ * \p key, any one of them may be removed; use #rbtree_remove() to remove a
+ * particular node.
+ *
+ * This function runs in <tt>O(log n)</tt> time with respect to the number of
+ * nodes in the tree, and does not use recursion.
+ *
+ * \param [in] tree The red-black tree from which to remove the node.
+ * \param [in] key Key of the node to remove.
+ *
+ * \return Returns the removed node, or \c NULL if no node matching the \p key
+ * exists in the tree.
+ */
+struct rbnode *rbtree_delete(struct rbtree *tree, const struct rbnode *key)
+{
+    struct rbnode **backtrace[MAX_RBTREE_DEPTH];
+    struct rbnode *node;
+    size_t current;
+    int cmp;
+
+    assert(tree != NULL);
+    assert(key != NULL);
+
+    RBCHECK(tree);
+
+    current = 0;
+    backtrace[current] = &tree->root;
+
+    while ((node = *backtrace[current]) != NULL)
+    {
+        cmp = tree->cmp(key, node);
+        if (cmp == 0)
+            break;
+
+        current++;
+        assert(current < MAX_RBTREE_DEPTH);
+
+        backtrace[current] = cmp < 0 ? &node->left : &node->right;
+    }
+
+    if (node != NULL)
+        _remove_at(tree, backtrace, current);
+
+    RBCHECK(tree);
+
+    return node;
+}
+
+/**
+ * \brief Remove \p node from \p tree.
+ *
+ * Removes exactly the given \p node, even if other nodes in the tree compare
+ * equal to it, then rebalances the tree. After removal, the node may be
+ * inserted again.
+ *
+ * This function runs in <tt>O(log n)</tt> time with respect to the number of
+ * nodes in the tree, plus the number of nodes comparing equal to \p node. It
+ * does not use recursion.
+ *
+ * \param [in] tree The red-black tree from which to remove \p node.
+ * \param [in] node The node to remove.
+ *
+ * \return Returns 0 if the node was removed, or -1 if it is not in the tree.
+ */
+int rbtree_remove(struct rbtree *tree, struct rbnode *node)
+{
+    struct rbnode **backtrace[MAX_RBTREE_DEPTH];
+    size_t current;
+
+    assert(tree != NULL);
+    assert(node != NULL);
+
+    RBCHECK(tree);
+
+    if (_find_path(tree, node, backtrace, &current) != 0)
+        return -1;
+
+    _remove_at(tree, backtrace, current);
+
+    RBCHECK(tree);
+
+    return 0;
+}
+
+/**
+ * \brief Point the iterator at the smallest node in the tree.
+ *
+ * This function runs in <tt>O(log n)</tt> time with respect to the number of
+ * nodes in the tree.
+ *
+ * \param [in] tree The red-black tree to iterate over.
+ * \param [out] it The iterator to set up.
+ *
+ * \return Returns the smallest node, or \c NULL if the tree is empty.
+ */
+struct rbnode *rbtree_first(const struct rbtree *tree, struct rbiter *it)
+{
+    assert(tree != NULL);
+    assert(it != NULL);
+
+    it->depth = 0;
+    _push_leftmost(it, tree->root);
+
+    return _iter_node(it);
+}
+
+/**
+ * \brief Point the iterator at the largest node in the tree.
+ *
+ * This function runs in <tt>O(log n)</tt> time with respect to the number of
+ * nodes in the tree.
+ *
+ * \param [in] tree The red-black tree to iterate over.
+ * \param [out] it The iterator to set up.
+ *
+ * \return Returns the largest node, or \c NULL if the tree is empty.
+ */
+struct rbnode *rbtree_last(const struct rbtree *tree, struct rbiter *it)
+{
+    assert(tree != NULL);
+    assert(it != NULL);
+
+    it->depth = 0;
+    _push_rightmost(it, tree->root);
+
+    return _iter_node(it);
+}
+
+/**
+ * \brief Move the iterator to the next node, in order.
+ *
+ * If the current node has a right subtree, the next node is the leftmost node
+ * in it. Otherwise, it is the nearest ancestor whose left subtree holds the
+ * current node. Walking the whole tree this way visits each edge twice, so
+ * stepping through \c k consecutive nodes costs <tt>O(log n + k)</tt> time.
+ *
+ * \param [in,out] it The iterator to move.
+ *
+ * \return Returns the next node, or \c NULL if the iterator moved past the
+ * largest node (or was already past either end).
+ */
+struct rbnode *rbtree_next(struct rbiter *it)
+{
+    struct rbnode *child;
+
+    assert(it != NULL);
+
+    if (it->depth == 0)
+        return NULL;
+
+    child = it->path[it->depth-1];
+    if (child->right != NULL)
+    {
+        _push_leftmost(it, child->right);
+    }
+    else
+    {
+        /* Climb until we come up from a left child. */
+        do
+        {
+            child = it->path[--it->depth];
+        } while (it->depth > 0 && it->path[it->depth-1]->right == child);
+    }
+
+    return _iter_node(it);
+}
+
+/**
+ * \brief Move the iterator to the previous node, in order.
+ *
+ * This is the mirror image of #rbtree_next(), with the same cost.
+ *
+ * \param [in,out] it The iterator to move.
+ *
+ * \return Returns the previous node, or \c NULL if the iterator moved past the
+ * smallest node (or was already past either end).
+ */
+struct rbnode *rbtree_prev(struct rbiter *it)
+{
+    struct rbnode *child;
+
+    assert(it != NULL);
+
+    if (it->depth == 0)
+        return NULL;
+
+    child = it->path[it->depth-1];
+    if (child->left != NULL)
+    {
+        _push_rightmost(it, child->left);
+    }
+    else
+    {
+        /* Climb until we come up from a right child. */
+        do
+        {
+            child = it->path[--it->depth];
+        } while (it->depth > 0 && it->path[it->depth-1]->left == child);
+    }
+
+    return _iter_node(it);
+}
+
+/**
+ * \brief Point the iterator at the first node not less than \p key.
+ *
+ * Together with #rbtree_next(), this gives range scans over the tree: visiting
+ * the \c k nodes in a range costs <tt>O(log n + k)</tt> time. If several nodes
+ * match the \p key, the iterator points at the first of them.
+ *
+ * \param [in] tree The red-black tree to search.
+ * \param [in] key Key to search for.
+ * \param [out] it The iterator to set up.
+ *
+ * \return Returns the smallest node greater than or equal to \p key, or \c
+ * NULL if there is no such node.
+ */
+struct rbnode *rbtree_lower_bound(const struct rbtree *tree,
+        const struct rbnode *key, struct rbiter *it)
+{
+    return _bound(tree, key, it, 0);
+}
+
+/**
+ * \brief Point the iterator at the first node greater than \p key.
+ *
+ * \param [in] tree The red-black tree to search.
+ * \param [in] key Key to search for.
+ * \param [out] it The iterator to set up.
+ *
+ * \return Returns the smallest node greater than \p key, or \c NULL if there
+ * is no such node.
+ */
+struct rbnode *rbtree_upper_bound(const struct rbtree *tree,
+        const struct rbnode *key, struct rbiter *it)
+{
+    return _bound(tree, key, it, 1);
+}
+
+/**
+ * \brief Find the node with the given rank.
+ *
+ * Walks down from the root, using the subtree sizes to decide which way to go.
+ * The tree must have been initialized with #rbtree_init_os().
+ *
+ * This function runs in <tt>O(log n)</tt> time with respect to the number of
+ * nodes in the tree.
+ *
+ * \param [in] tree The red-black tree to search.
+ * \param [in] k Zero-based rank of the node to find, so that 0 selects the
+ * smallest node.
+ *
+ * \return Returns the node with \p k smaller nodes before it in order, or \c
+ * NULL if the tree has no more than \p k nodes.
+ */
+struct rbnode *rbtree_select(const struct rbtree *tree, size_t k)
+{
+    struct rbnode *cur;
+    size_t left;
+
+    assert(tree != NULL);
+    assert(tree->order);
+
+    cur = tree->root;
+    while (cur != NULL)
+    {
+        left = _size(cur->left);
+
+        if (k < left)
+        {
+            cur = cur->left;
+        }
+        else if (k > left)
+        {
+            k -= left + 1;
+            cur = cur->right;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return cur;
+}
+
+/**
+ * \brief Count the nodes that are smaller than \p key.
+ *
+ * This is the rank the \p key would have if it were inserted before any equal
+ * nodes, so it is also the rank of the node returned by #rbtree_lower_bound().
+ * The tree must have been initialized with #rbtree_init_os().
+ *
+ * This function runs in <tt>O(log n)</tt> time with respect to the number of
+ * nodes in the tree.
+ *
+ * \param [in] tree The red-black tree to search.
+ * \param [in] key Key to compare against.
+ *
+ * \return Returns the number of nodes in the tree that compare less than \p
+ * key.
+ */
+size_t rbtree_rank(const struct rbtree *tree, const struct rbnode *key)
+{
+    struct rbnode *cur;
+    size_t rank;
+
+    assert(tree != NULL);
+    assert(key != NULL);
+    assert(tree->order);
+
+    rank = 0;
+    cur = tree->root;
+    while (cur != NULL)
+    {
+        if (tree->cmp(key, cur) <= 0)
+        {
+            cur = cur->left;
+        }
+        else
+        {
+            rank += _size(cur->left) + 1;
+            cur = cur->right;
+        }
+    }
+
+    return rank;
+}
+
+/**
+ * \brief Get the number of nodes in the tree.
+ *
+ * The tree must have been initialized with #rbtree_init_os(); otherwise,
+ * counting the nodes would take <tt>O(n)</tt> time.
+ *
+ * \param [in] tree The red-black tree.
+ *
+ * \return Returns the number of nodes in the tree.
+ *
+ * \note This operation has a time complexity of O(1).
+ */
+size_t rbtree_size(const struct rbtree *tree)
+{
+    assert(tree != NULL);
+    assert(tree->order);
+
+    return _size(tree->root);
+}
+
 /**
  * \brief Run a callback on each element of the tree, in order.
  *
@@ -57,8 +57,21 @@
 #define _RBTREE_H_
 
 
+#include <stddef.h>
+
 #include "utils.h"
 
+/**
+ * \brief Maximum achievable depth of a red-black tree.
+ *
+ * The maximum depth is determined by the memory size of the machine; this value
+ * should be larger than the max possible depth of the tree, but small enough
+ * that an array of this size can easily be created. The size is used to keep a
+ * path from a node to the root in #rbtree_insert(), #rbtree_remove() and
+ * #rbiter to avoid storing parent pointers in each node.
+ */
+#define MAX_RBTREE_DEPTH 128
+
 /**
  * \brief Node in a red-black tree.
  *
@@ -74,6 +87,21 @@ struct rbnode
     enum { RB_BLACK, RB_RED } color;            /**< Color of the node. */
 };
 
+/**
+ * \brief Node in a red-black tree that keeps order statistics.
+ *
+ * Trees initialized with #rbtree_init_os() store the size of every subtree, so
+ * that nodes can be found by rank. Every node in such a tree must be embedded
+ * in one of these, and the embedded \c rbn is what is passed to the tree
+ * functions. Other trees can use a plain #rbnode, and pay nothing for the
+ * sizes.
+ */
+struct rbosnode
+{
+    struct rbnode rbn; /**< The node itself. */
+    size_t size;       /**< Number of nodes in the subtree rooted here. */
+};
+
 /**
  * \brief Function for processing nodes in the red-black tree.
  */
@@ -86,12 +114,45 @@ struct rbtree
 {
     struct rbnode *root; /**< Root node of the tree. */
     cmp_func cmp;        /**< Node comparison function. */
+    int order;           /**< Nonzero if the nodes are #rbosnode, keeping
+                              subtree sizes. */
+};
+
+/**
+ * \brief Iterator over the nodes of a red-black tree, in order.
+ *
+ * Since nodes do not have parent pointers, the iterator keeps the path from the
+ * root to the current node. Set it up with #rbtree_first(), #rbtree_last(),
+ * #rbtree_lower_bound() or #rbtree_upper_bound(), then move it with
+ * #rbtree_next() and #rbtree_prev(). The iterator is invalidated by any
+ * insertion into or removal from the tree.
+ */
+struct rbiter
+{
+    struct rbnode *path[MAX_RBTREE_DEPTH]; /**< Nodes from the root to the
+                                                current node. */
+    size_t depth;                          /**< Number of nodes in \c path;
+                                                0 past either end. */
 };
 
 void rbtree_init(struct rbtree *tree, cmp_func compare);
+void rbtree_init_os(struct rbtree *tree, cmp_func compare);
 struct rbnode *rbtree_search(const struct rbtree *tree,
         const struct rbnode *key);
 void rbtree_insert(struct rbtree *tree, struct rbnode *to_add);
+struct rbnode *rbtree_delete(struct rbtree *tree, const struct rbnode *key);
+int rbtree_remove(struct rbtree *tree, struct rbnode *node);
+struct rbnode *rbtree_first(const struct rbtree *tree, struct rbiter *it);
+struct rbnode *rbtree_last(const struct rbtree *tree, struct rbiter *it);
+struct rbnode *rbtree_next(struct rbiter *it);
+struct rbnode *rbtree_prev(struct rbiter *it);
+struct rbnode *rbtree_lower_bound(const struct rbtree *tree,
+        const struct rbnode *key, struct rbiter *it);
+struct rbnode *rbtree_upper_bound(const struct rbtree *tree,
+        const struct rbnode *key, struct rbiter *it);
+struct rbnode *rbtree_select(const struct rbtree *tree, size_t k);
+size_t rbtree_rank(const struct rbtree *tree, const struct rbnode *key);
+size_t rbtree_size(const struct rbtree *tree);
 int rbtree_traverse(const struct rbtree *tree, RBCallback callback,
         void *scratch);
 
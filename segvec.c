@@ -0,0 +1,332 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file segvec.c
+ *
+ * \brief Segmented vectors with stable element addresses.
+ *
+ * Element \c i of the vector lives in chunk \c k at offset \c o, where
+ * <tt>i + SEGVEC_BASE = (SEGVEC_BASE << k) + o</tt>. That is, adding
+ * #SEGVEC_BASE to the index makes the position of its highest set bit select
+ * the chunk, and the remaining bits give the offset within that chunk.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "segvec.h"
+#include "vector.h"
+
+/**
+ * \brief Get the index of the highest set bit in \p n.
+ *
+ * \param [in] n Number of which to find the highest set bit.
+ *
+ * \return Returns <tt>floor(log2(n))</tt>.
+ *
+ * \pre <tt>n != 0</tt>
+ */
+static size_t _log2(size_t n)
+{
+    assert(n != 0);
+
+#if defined(__GNUC__) && SIZE_MAX == ULONG_MAX
+    return sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl(n);
+#else
+    {
+        size_t ret = 0;
+
+        while (n >>= 1)
+            ret++;
+
+        return ret;
+    }
+#endif
+}
+
+/**
+ * \brief Get the number of elements in chunk \p k.
+ */
+#define _chunklen(k)    (SEGVEC_BASE << (k))
+
+/**
+ * \brief Initialize a segmented vector so that it is ready to be used.
+ *
+ * No memory is allocated until the first element is pushed.
+ *
+ * \param [out] sv Segmented vector to initialize.
+ * \param [in] elemsize Size of each element in the vector.
+ * \param [in] alloc Memory allocator used for allocating the chunks. Interface
+ * should be equivalent to \c realloc.
+ *
+ * \return Always returns \c 0.
+ *
+ * \pre <tt>sv != NULL</tt>
+ * \pre <tt>elemsize != 0</tt>
+ */
+int segvec_init(struct segvec *sv, size_t elemsize,
+        void *(*alloc)(void *, size_t))
+{
+    assert(sv != NULL);
+    assert(elemsize != 0);
+    assert(alloc != NULL);
+
+    sv->realloc = alloc;
+    sv->len = 0;
+    sv->elemsize = elemsize;
+    sv->nchunks = 0;
+
+    return 0;
+}
+
+/**
+ * \brief Free all the memory associated with the segmented vector.
+ *
+ * Any pointers to elements of the vector are invalid after this is called.
+ *
+ * \param [in,out] sv Segmented vector to destroy.
+ *
+ * \pre <tt>sv != NULL</tt>
+ */
+void segvec_destroy(struct segvec *sv)
+{
+    assert(sv != NULL);
+
+    sv->len = 0;
+    segvec_shrink(sv);
+}
+
+/**
+ * \brief Add an element to the end of the segmented vector.
+ *
+ * If the last chunk is full, a new chunk twice its size is allocated. None of
+ * the existing elements are moved.
+ *
+ * \param [in,out] sv Segmented vector to which the element is added.
+ * \param [in] e Element to copy onto the end of the vector.
+ *
+ * \return Returns \c 0 if the element was added. Returns \c -1 if a new chunk
+ * was needed and the allocation failed, in which case the vector is unchanged.
+ *
+ * \pre <tt>sv != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(1), not counting
+ * the allocator.
+ */
+int segvec_push(struct segvec *sv, const void *e)
+{
+    char *chunk;
+
+    assert(sv != NULL);
+    assert(e != NULL);
+
+    if (sv->len == segvec_space(sv))
+    {
+        assert(sv->nchunks < SEGVEC_MAX_CHUNKS);
+
+        chunk = sv->realloc(NULL, _chunklen(sv->nchunks) * sv->elemsize);
+        if (chunk == NULL)
+            return -1;
+
+        sv->chunks[sv->nchunks++] = chunk;
+    }
+
+    sv->len++;
+    segvec_set(sv, sv->len - 1, e);
+
+    return 0;
+}
+
+/**
+ * \brief Remove the last element from the segmented vector.
+ *
+ * The memory for the element is not freed until #segvec_shrink() is called.
+ *
+ * \param [in,out] sv Segmented vector from which to remove an element.
+ *
+ * \return Returns \c 0 if an element was removed. Returns \c -1 if the vector
+ * was empty.
+ *
+ * \pre <tt>sv != NULL</tt>
+ */
+int segvec_pop(struct segvec *sv)
+{
+    assert(sv != NULL);
+
+    if (segvec_isempty(sv))
+        return -1;
+
+    sv->len--;
+
+    return 0;
+}
+
+/**
+ * \brief Get the element stored at the given index.
+ *
+ * The returned pointer stays valid until the element is popped and the vector
+ * is shrunk, or the vector is destroyed; pushing more elements never moves it.
+ *
+ * \param [in] sv Segmented vector from which to get the element.
+ * \param [in] i Index of the element.
+ *
+ * \return Returns a pointer to element \p i.
+ *
+ * \pre <tt>sv != NULL</tt>
+ * \pre <tt>i < segvec_len(sv)</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(1).
+ */
+void *segvec_get(const struct segvec *sv, size_t i)
+{
+    size_t k;
+
+    assert(sv != NULL);
+    assert(i < segvec_len(sv));
+
+    i += SEGVEC_BASE;
+    k = _log2(i) - SEGVEC_BASE_SHIFT;
+
+    assert(k < sv->nchunks);
+
+    return sv->chunks[k] + (i - _chunklen(k)) * sv->elemsize;
+}
+
+/**
+ * \brief Set the element at the given index to a new value.
+ *
+ * \param [in,out] sv Segmented vector in which to set the element.
+ * \param [in] i Index of the element to set.
+ * \param [in] e New value to copy into the element.
+ *
+ * \pre <tt>sv != NULL</tt>
+ * \pre <tt>i < segvec_len(sv)</tt>
+ */
+void segvec_set(struct segvec *sv, size_t i, const void *e)
+{
+    memcpy(segvec_get(sv, i), e, sv->elemsize);
+}
+
+/**
+ * \brief Get the number of elements in the segmented vector.
+ *
+ * \param [in] sv Segmented vector to count the elements of.
+ *
+ * \return Returns the number of elements in \p sv.
+ *
+ * \pre <tt>sv != NULL</tt>
+ */
+size_t segvec_len(const struct segvec *sv)
+{
+    assert(sv != NULL);
+
+    return sv->len;
+}
+
+/**
+ * \brief Get the number of elements that fit in the allocated chunks.
+ *
+ * \param [in] sv Segmented vector to count the space of.
+ *
+ * \return Returns the total number of elements that fit in \p sv before
+ * another chunk must be allocated.
+ *
+ * \pre <tt>sv != NULL</tt>
+ */
+size_t segvec_space(const struct segvec *sv)
+{
+    assert(sv != NULL);
+
+    /* The chunks hold SEGVEC_BASE * (1 + 2 + ... + 2^(n-1)) elements. */
+    return SEGVEC_BASE * (((size_t)1 << sv->nchunks) - 1);
+}
+
+/**
+ * \brief Determine if the segmented vector is empty.
+ *
+ * \param [in] sv Segmented vector to check for emptiness.
+ *
+ * \return Returns nonzero if \p sv is empty, or zero otherwise.
+ *
+ * \pre <tt>sv != NULL</tt>
+ */
+int segvec_isempty(const struct segvec *sv)
+{
+    return segvec_len(sv) == 0;
+}
+
+/**
+ * \brief Free any chunks that no longer hold elements.
+ *
+ * \param [in,out] sv Segmented vector to shrink.
+ *
+ * \pre <tt>sv != NULL</tt>
+ */
+void segvec_shrink(struct segvec *sv)
+{
+    assert(sv != NULL);
+
+    while (sv->nchunks > 0
+            && segvec_space(sv) - _chunklen(sv->nchunks - 1) >= sv->len)
+    {
+        sv->nchunks--;
+        sv->realloc(sv->chunks[sv->nchunks], 0);
+    }
+}
+
+/**
+ * \brief Apply an operator to each element in a segmented vector.
+ *
+ * This walks the vector one chunk at a time, so it is cheaper than calling
+ * #segvec_get() for every index.
+ *
+ * \param [in,out] sv Segmented vector to map the operator over.
+ * \param [in] op Operator applied to each element, in index order.
+ * \param [in] scratch Scratch argument passed directly to \p op.
+ *
+ * \pre <tt>sv != NULL</tt>
+ * \pre <tt>op != NULL</tt>
+ */
+void segvec_map(struct segvec *sv, vec_operator op, void *scratch)
+{
+    size_t i, k, o;
+
+    assert(sv != NULL);
+    assert(op != NULL);
+
+    i = 0;
+    for (k = 0; i < sv->len; k++)
+    {
+        for (o = 0; o < _chunklen(k) && i < sv->len; o++, i++)
+            op(sv->chunks[k] + o * sv->elemsize, i, scratch);
+    }
+}
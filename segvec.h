@@ -0,0 +1,103 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file segvec.h
+ *
+ * \brief Segmented vectors with stable element addresses.
+ *
+ * A segmented vector is a dynamically-resizable array that grows by adding new
+ * chunks of memory rather than by reallocating a single buffer. Elements are
+ * never moved once they have been added, so pointers returned by
+ * #segvec_get() stay valid until the element is popped or the vector is
+ * destroyed. Growing the vector never copies any elements, so there are no
+ * latency spikes when the vector grows.
+ *
+ * Chunk \c k holds <tt>SEGVEC_BASE << k</tt> elements, so the chunks double in
+ * size and the number of chunks is logarithmic in the number of elements. The
+ * chunk and offset of an element can be computed directly from its index,
+ * giving O(1) indexed access through a small, fixed-size chunk directory.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _SEGVEC_H_
+#define _SEGVEC_H_
+
+
+#include <limits.h>
+#include <stddef.h>
+
+#include "vector.h"
+
+/**
+ * \brief Base-2 logarithm of the number of elements in the first chunk.
+ */
+#define SEGVEC_BASE_SHIFT   5
+
+/**
+ * \brief Number of elements in the first chunk of a segmented vector.
+ */
+#define SEGVEC_BASE         ((size_t)1 << SEGVEC_BASE_SHIFT)
+
+/**
+ * \brief Number of entries in the chunk directory.
+ *
+ * This is enough chunks to hold any index that fits in a \c size_t.
+ */
+#define SEGVEC_MAX_CHUNKS   (sizeof(size_t) * CHAR_BIT - SEGVEC_BASE_SHIFT)
+
+/**
+ * \brief Array-like data type made of geometrically-sized chunks.
+ *
+ * Must be initialized with #segvec_init() before it can be used, and destroyed
+ * with #segvec_destroy() when it is no longer needed.
+ */
+struct segvec
+{
+    char *chunks[SEGVEC_MAX_CHUNKS];  /**< Chunk directory. Only the first \c
+                                           nchunks entries are allocated. */
+    void *(*realloc)(void *, size_t); /**< Allocator for getting more memory. */
+    size_t len;                       /**< Number of elements in the vector. */
+    size_t elemsize;                  /**< Size of each element. */
+    size_t nchunks;                   /**< Number of allocated chunks. */
+};
+
+int segvec_init(struct segvec *sv, size_t elemsize,
+        void *(*alloc)(void *, size_t));
+void segvec_destroy(struct segvec *sv);
+int segvec_push(struct segvec *sv, const void *e);
+int segvec_pop(struct segvec *sv);
+void *segvec_get(const struct segvec *sv, size_t i);
+void segvec_set(struct segvec *sv, size_t i, const void *e);
+size_t segvec_len(const struct segvec *sv);
+size_t segvec_space(const struct segvec *sv);
+int segvec_isempty(const struct segvec *sv);
+void segvec_shrink(struct segvec *sv);
+void segvec_map(struct segvec *sv, vec_operator op, void *scratch);
+
+
+#endif /* end of include guard: _SEGVEC_H_ */
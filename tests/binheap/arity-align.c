@@ -0,0 +1,70 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "binheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 4096
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED 1234
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const uint64_t *_a, *_b;
+
+    _a = a;
+    _b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+int main(int argc, char *argv[])
+{
+    struct binheap uut;
+    size_t arity, group, k, c;
+    uintptr_t addr;
+    uint64_t e;
+    unsigned i;
+
+    srand(TEST_SEED);
+
+    for (arity = 2; arity <= BINHEAP_MAX_ARITY; arity *= 2)
+    {
+        assert(binheap_init_arity(&uut, cmp, sizeof(uint64_t), 0, arity) == 0);
+
+        for (i = 0; i < TEST_SIZE; i++)
+        {
+            e = (uint64_t)rand();
+            binheap_push(&uut, &e);
+        }
+
+        /* The root comes after 'arity - 1' unused slots. */
+        assert(binheap_len(&uut) == TEST_SIZE);
+        assert(binheap_peek(&uut) == vec_get(&uut.vec, arity - 1));
+
+        /* The children of the node at index 'k + arity - 2' are the siblings
+         * starting at index 'k * arity', and never straddle a cache line. */
+        group = arity * sizeof(uint64_t);
+        for (k = 1; k * arity < vec_len(&uut.vec); k++)
+        {
+            addr = (uintptr_t)vec_get(&uut.vec, k * arity);
+            if (group >= BINHEAP_CACHE_LINE)
+                assert(addr % BINHEAP_CACHE_LINE == 0);
+            else
+                assert(addr % group == 0);
+
+            for (c = k * arity; c < (k + 1) * arity && c < vec_len(&uut.vec);
+                    c++)
+                assert(cmp(vec_get(&uut.vec, k + arity - 2),
+                            vec_get(&uut.vec, c)) <= 0);
+        }
+
+        binheap_destroy(&uut);
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "binheap.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+/* Bigger than BINHEAP_HOLE_MAX, so heapify has to sift by swapping. */
+struct big
+{
+    int key;
+    char payload[BINHEAP_HOLE_MAX * 2];
+};
+
+static struct big elems[TEST_SIZE];
+
+int cmp(const void *a, const void *b)
+{
+    const struct big *_a = a, *_b = b;
+
+    return _a->key - _b->key;
+}
+
+static void check(struct binheap *uut)
+{
+    struct big *top;
+    int i;
+
+    assert(binheap_len(uut) == TEST_SIZE);
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        top = binheap_peek(uut);
+        assert(top->key == i);
+        assert(top->payload[0] == (char)i);
+        assert(top->payload[sizeof(top->payload) - 1] == (char)i);
+        binheap_pop(uut);
+    }
+    assert(binheap_isempty(uut));
+}
+
+int main(int argc, char *argv[])
+{
+    struct binheap uut;
+    struct vector v;
+    void *data;
+    int i;
+
+    /* Each key is used once, in a scattered order. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        elems[i].key = (i * 7919) % TEST_SIZE;
+        memset(elems[i].payload, elems[i].key, sizeof(elems[i].payload));
+    }
+
+    /* An exactly-sized vector is heapified in place, without growing. */
+    assert(vec_init(&v, sizeof(struct big), TEST_SIZE, realloc) == 0);
+    assert(vec_extend(&v, elems, TEST_SIZE) == 0);
+    data = vec_get(&v, 0);
+
+    binheap_heapify(&uut, cmp, &v);
+    assert(vec_get(&uut.vec, 0) == data);
+    check(&uut);
+    binheap_destroy(&uut);
+
+    assert(binheap_init_from(&uut, cmp, sizeof(struct big), elems, TEST_SIZE,
+                realloc) == 0);
+    check(&uut);
+    binheap_destroy(&uut);
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "binheap.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a, *_b;
+
+    _a = a;
+    _b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct binheap uut;
+    struct vector v;
+    int i;
+
+    /* Worst case for sifting down: every element is in reverse order. */
+    vec_init(&v, sizeof(int), 0, realloc);
+    for (i = TEST_SIZE - 1; i >= 0; i--)
+        vec_push(&v, &i);
+
+    binheap_heapify(&uut, cmp, &v);
+    assert(binheap_len(&uut) == TEST_SIZE);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(*(int *)binheap_peek(&uut) == i);
+        binheap_pop(&uut);
+    }
+
+    /* Pushing still works on a heapified vector. */
+    binheap_push(&uut, &i);
+    assert(*(int *)binheap_peek(&uut) == TEST_SIZE);
+
+    binheap_destroy(&uut);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "binheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 4096
+#endif
+
+/* Same size as a cache line, like a typical timer queue entry. */
+struct timer
+{
+    unsigned long deadline;
+    unsigned long id;
+    char payload[48];
+};
+
+int cmp(const void *a, const void *b)
+{
+    const struct timer *_a = a, *_b = b;
+
+    return (_a->deadline > _b->deadline) - (_a->deadline < _b->deadline);
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t arities[] = { 2, 4, 8 };
+    struct binheap uut;
+    struct timer t, *top;
+    unsigned long last;
+    size_t a, i, popped;
+
+    for (a = 0; a < sizeof(arities) / sizeof(*arities); a++)
+    {
+        assert(binheap_init_arity(&uut, cmp, sizeof(struct timer), 0,
+                    arities[a]) == 0);
+        srand(42);
+
+        /* Interleave pushes and pops, so that elements are sifted both up
+         * and down through a partly filled heap. */
+        last = 0;
+        popped = 0;
+        for (i = 0; i < TEST_SIZE; i++)
+        {
+            t.deadline = last + rand() % 1000;
+            t.id = i;
+            memset(t.payload, (int)(i & 0xff), sizeof(t.payload));
+            assert(binheap_push(&uut, &t) != -1);
+
+            if (i % 3 == 2)
+            {
+                top = binheap_peek(&uut);
+                assert(top->deadline >= last);
+                last = top->deadline;
+                assert(binheap_pop(&uut) == 0);
+                popped++;
+            }
+        }
+
+        /* Every element must come back whole, in order. */
+        last = 0;
+        while (!binheap_isempty(&uut))
+        {
+            top = binheap_peek(&uut);
+            assert(top->deadline >= last);
+            last = top->deadline;
+
+            memset(t.payload, (int)(top->id & 0xff), sizeof(t.payload));
+            assert(memcmp(top->payload, t.payload, sizeof(t.payload)) == 0);
+
+            assert(binheap_pop(&uut) == 0);
+            popped++;
+        }
+        assert(popped == TEST_SIZE);
+        assert(binheap_pop(&uut) == -1);
+
+        binheap_destroy(&uut);
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "binheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a, *_b;
+
+    _a = a;
+    _b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct binheap uut;
+    int i, e, out;
+
+    binheap_init(&uut, cmp, sizeof(int), 0, realloc);
+
+    /* On an empty heap, the pushed element comes straight back out. */
+    e = 5;
+    binheap_pushpop(&uut, &e, &out);
+    assert(out == 5);
+    assert(binheap_isempty(&uut));
+
+    /* The heap holds the even numbers. */
+    for (i = 0; i < TEST_SIZE; i += 2)
+        binheap_push(&uut, &i);
+
+    /* Pushing something smaller than the minimum leaves the heap alone. */
+    e = -1;
+    binheap_pushpop(&uut, &e, &out);
+    assert(out == -1);
+    assert(binheap_len(&uut) == TEST_SIZE / 2);
+    assert(*(int *)binheap_peek(&uut) == 0);
+
+    /* Otherwise the minimum is popped, and the new element stays. Pushing
+     * bigger numbers pops the evens in order. */
+    for (i = 0; i < TEST_SIZE / 2; i++)
+    {
+        e = TEST_SIZE + i;
+        binheap_pushpop(&uut, &e, &out);
+        assert(out == 2 * i);
+        assert(binheap_len(&uut) == TEST_SIZE / 2);
+    }
+
+    for (i = 0; i < TEST_SIZE / 2; i++)
+    {
+        assert(binheap_pop_into(&uut, &out) == 0);
+        assert(out == TEST_SIZE + i);
+    }
+    out = 42;
+    assert(binheap_pop_into(&uut, &out) == -1);
+    assert(out == 42);
+
+    binheap_destroy(&uut);
+
+    return 0;
+}
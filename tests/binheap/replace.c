@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "binheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 256
+#endif
+
+#ifndef NUM_RUNS
+#define NUM_RUNS 8
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a, *_b;
+
+    _a = a;
+    _b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct binheap uut;
+    int next[NUM_RUNS];
+    int i, e, out, last;
+
+    binheap_init_arity(&uut, cmp, sizeof(int), 0, 4);
+
+    e = 1;
+    assert(binheap_replace(&uut, &e, &out) == -1);
+    assert(binheap_isempty(&uut));
+
+    /* Merge NUM_RUNS sorted runs, where run r holds r, r + NUM_RUNS, ... The
+     * heap holds the head of each run. */
+    for (i = 0; i < NUM_RUNS; i++)
+    {
+        binheap_push(&uut, &i);
+        next[i] = i + NUM_RUNS;
+    }
+
+    last = -1;
+    for (i = 0; i < NUM_RUNS * TEST_SIZE; i++)
+    {
+        e = *(int *)binheap_peek(&uut);
+        if (next[e % NUM_RUNS] < NUM_RUNS * TEST_SIZE)
+        {
+            assert(binheap_replace(&uut, &next[e % NUM_RUNS], &out) == 0);
+            next[e % NUM_RUNS] += NUM_RUNS;
+        }
+        else
+        {
+            assert(binheap_pop_into(&uut, &out) == 0);
+        }
+
+        assert(out == e);
+        assert(out == last + 1);
+        last = out;
+    }
+    assert(binheap_isempty(&uut));
+
+    /* Replacing always keeps the new element, even if it is the smallest. */
+    e = 10;
+    binheap_push(&uut, &e);
+    e = 3;
+    assert(binheap_replace(&uut, &e, NULL) == 0);
+    assert(binheap_len(&uut) == 1);
+    assert(*(int *)binheap_peek(&uut) == 3);
+
+    binheap_destroy(&uut);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "fibheap.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif /* TEST_SIZE */
+
+struct uut_elem
+{
+    struct fibheap_elem fe;
+    int n;
+};
+
+static struct uut_elem elems[TEST_SIZE];
+
+int cmp(const void *a, const void *b)
+{
+    const struct uut_elem *_a, *_b;
+
+    _a = containerof(a, struct uut_elem, fe);
+    _b = containerof(b, struct uut_elem, fe);
+
+    return _a->n - _b->n;
+}
+
+int main(int argc, char *argv[])
+{
+    struct uut_elem *cur;
+    struct fibheap uut;
+    int i, j, prev;
+
+    fibheap_init(&uut, cmp);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        fibheap_elem_init(&elems[i].fe);
+        elems[i].n = TEST_SIZE + rand() % TEST_SIZE;
+        fibheap_push(&uut, &elems[i].fe);
+    }
+
+    /* Pop once, so that the roots are linked into trees. */
+    cur = containerof(fibheap_pop(&uut), struct uut_elem, fe);
+    cur->n = -1;
+
+    /* Decrease keys at random. Decreasing the same subtrees again and again
+     * exercises the cascading cuts, and some keys become the new minimum. */
+    for (i = 0; i < 4 * TEST_SIZE; i++)
+    {
+        j = rand() % TEST_SIZE;
+        if (elems[j].n < 0)
+            continue;
+
+        elems[j].n -= rand() % (elems[j].n / 8 + 1);
+        fibheap_decrease_key(&uut, &elems[j].fe);
+
+        cur = containerof(fibheap_peek(&uut), struct uut_elem, fe);
+        assert(cur->n <= elems[j].n);
+
+        /* Pop now and then to build deeper trees. */
+        if (i % 64 == 0)
+        {
+            cur = containerof(fibheap_pop(&uut), struct uut_elem, fe);
+            cur->n = TEST_SIZE + rand() % TEST_SIZE;
+            fibheap_push(&uut, &cur->fe);
+        }
+    }
+
+    fibheap_decrease_key(&uut, fibheap_peek(&uut));
+
+    /* Everything must still come out in order. */
+    prev = -1;
+    for (i = 0; i < TEST_SIZE - 1; i++)
+    {
+        assert(!fibheap_isempty(&uut));
+        cur = containerof(fibheap_pop(&uut), struct uut_elem, fe);
+        assert(cur->n >= prev);
+        prev = cur->n;
+    }
+    assert(fibheap_isempty(&uut));
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "fibheap.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif /* TEST_SIZE */
+
+struct uut_elem
+{
+    struct fibheap_elem fe;
+    int n;
+};
+
+static struct uut_elem elems[TEST_SIZE];
+
+int cmp(const void *a, const void *b)
+{
+    const struct uut_elem *_a, *_b;
+
+    _a = containerof(a, struct uut_elem, fe);
+    _b = containerof(b, struct uut_elem, fe);
+
+    return _a->n - _b->n;
+}
+
+int main(int argc, char *argv[])
+{
+    struct fibheap uut0;
+    struct fibheap uut1;
+    struct uut_elem *prev, *cur;
+    size_t i;
+
+    fibheap_init(&uut0, cmp);
+    fibheap_init(&uut1, cmp);
+
+    /* Merging an empty heap does nothing. */
+    fibheap_merge(&uut0, &uut1);
+    assert(fibheap_isempty(&uut0));
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        elems[i].n = rand();
+        fibheap_elem_init(&elems[i].fe);
+    }
+
+    for (i = 0; i < TEST_SIZE / 2; i++)
+    {
+        fibheap_push(&uut0, &elems[2*i].fe);
+        fibheap_push(&uut1, &elems[2*i + 1].fe);
+    }
+
+    /* Give the second heap some trees before merging. */
+    cur = containerof(fibheap_pop(&uut1), struct uut_elem, fe);
+    fibheap_push(&uut1, &cur->fe);
+
+    fibheap_merge(&uut0, &uut1);
+
+    assert(fibheap_isempty(&uut1));
+    assert(fibheap_len(&uut1) == 0);
+    assert(fibheap_len(&uut0) == TEST_SIZE);
+
+    prev = containerof(fibheap_pop(&uut0), struct uut_elem, fe);
+
+    for (i = 1; i < TEST_SIZE; i++)
+    {
+        assert(!fibheap_isempty(&uut0));
+
+        cur = containerof(fibheap_pop(&uut0), struct uut_elem, fe);
+        assert(prev->n <= cur->n);
+
+        prev = cur;
+    }
+
+    assert(fibheap_isempty(&uut0));
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "fibheap.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif /* TEST_SIZE */
+
+struct uut_elem
+{
+    struct fibheap_elem fe;
+    int n;
+};
+
+static struct uut_elem elems[TEST_SIZE];
+
+int cmp(const void *a, const void *b)
+{
+    const struct uut_elem *_a, *_b;
+
+    _a = containerof(a, struct uut_elem, fe);
+    _b = containerof(b, struct uut_elem, fe);
+
+    return _a->n - _b->n;
+}
+
+int main(int argc, char *argv[])
+{
+    struct uut_elem *cur, *prev;
+    struct fibheap uut;
+    size_t i;
+
+    fibheap_init(&uut, cmp);
+    assert(fibheap_isempty(&uut));
+    assert(fibheap_peek(&uut) == NULL);
+    assert(fibheap_pop(&uut) == NULL);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        fibheap_elem_init(&elems[i].fe);
+        elems[i].n = rand() % TEST_SIZE;
+        fibheap_push(&uut, &elems[i].fe);
+        assert(fibheap_len(&uut) == i + 1);
+    }
+
+    /* Pop half and push them back, so that the trees are consolidated while
+     * new roots keep arriving. */
+    for (i = 0; i < TEST_SIZE / 2; i++)
+    {
+        cur = containerof(fibheap_pop(&uut), struct uut_elem, fe);
+        cur->n += rand() % TEST_SIZE;
+        fibheap_push(&uut, &cur->fe);
+    }
+    assert(fibheap_len(&uut) == TEST_SIZE);
+
+    prev = containerof(fibheap_pop(&uut), struct uut_elem, fe);
+    for (i = 1; i < TEST_SIZE; i++)
+    {
+        assert(!fibheap_isempty(&uut));
+        cur = containerof(fibheap_peek(&uut), struct uut_elem, fe);
+        assert(fibheap_pop(&uut) == &cur->fe);
+        assert(prev->n <= cur->n);
+        assert(fibheap_len(&uut) == TEST_SIZE - i - 1);
+        prev = cur;
+    }
+
+    assert(fibheap_isempty(&uut));
+
+    return 0;
+}
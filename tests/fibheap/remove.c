@@ -0,0 +1,75 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "fibheap.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif /* TEST_SIZE */
+
+struct uut_elem
+{
+    struct fibheap_elem fe;
+    int n;
+};
+
+static struct uut_elem elems[TEST_SIZE];
+
+int cmp(const void *a, const void *b)
+{
+    const struct uut_elem *_a, *_b;
+
+    _a = containerof(a, struct uut_elem, fe);
+    _b = containerof(b, struct uut_elem, fe);
+
+    return _a->n - _b->n;
+}
+
+int main(int argc, char *argv[])
+{
+    struct uut_elem *cur;
+    struct fibheap uut;
+    int i;
+
+    fibheap_init(&uut, cmp);
+
+    /* Element i has the key (i * 7919) % TEST_SIZE, so each key is used
+     * once. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        fibheap_elem_init(&elems[i].fe);
+        elems[i].n = (i * 7919) % TEST_SIZE;
+        fibheap_push(&uut, &elems[i].fe);
+    }
+
+    /* Pop a few, so that there are trees below the roots. */
+    for (i = 0; i < 4; i++)
+        assert(containerof(fibheap_pop(&uut), struct uut_elem, fe)->n == i);
+
+    /* Remove every element with an odd key, including the minimum when it is
+     * odd. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        if (elems[i].n % 2 == 1 && elems[i].n >= 4)
+            fibheap_remove(&uut, &elems[i].fe);
+    }
+    assert(fibheap_len(&uut) == (TEST_SIZE - 4) / 2);
+
+    for (i = 4; i < TEST_SIZE; i += 2)
+    {
+        assert(!fibheap_isempty(&uut));
+        cur = containerof(fibheap_pop(&uut), struct uut_elem, fe);
+        assert(cur->n == i);
+    }
+    assert(fibheap_isempty(&uut));
+
+    /* Removed elements can be pushed again, and removing the only element
+     * empties the heap. */
+    fibheap_push(&uut, &elems[1].fe);
+    fibheap_remove(&uut, &elems[1].fe);
+    assert(fibheap_isempty(&uut));
+    assert(fibheap_len(&uut) == 0);
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "iheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 512
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct iheap uut;
+    size_t handles[TEST_SIZE];
+    int keys[TEST_SIZE];
+    int i, j, k, min;
+
+    srand(7);
+    assert(iheap_init(&uut, cmp, sizeof(int), 0, realloc) == 0);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        keys[i] = rand() % 10000;
+        handles[i] = iheap_push(&uut, &keys[i]);
+        assert(handles[i] != IHEAP_NONE);
+    }
+
+    /* Reschedule elements at random, in both directions, and check that the
+     * minimum always matches. */
+    for (i = 0; i < 4 * TEST_SIZE; i++)
+    {
+        j = rand() % TEST_SIZE;
+        k = rand() % 10000;
+
+        if (k < keys[j])
+            iheap_decrease_key(&uut, handles[j], &k);
+        else
+            iheap_increase_key(&uut, handles[j], &k);
+        keys[j] = k;
+        assert(*(int *)iheap_get(&uut, handles[j]) == k);
+
+        min = keys[0];
+        for (k = 1; k < TEST_SIZE; k++)
+            if (keys[k] < min)
+                min = keys[k];
+        assert(*(int *)iheap_peek(&uut) == min);
+    }
+    assert(iheap_len(&uut) == TEST_SIZE);
+
+    /* Changing the element in place works too. */
+    *(int *)iheap_get(&uut, handles[3]) = -1;
+    iheap_decrease_key(&uut, handles[3], iheap_get(&uut, handles[3]));
+    assert(iheap_peek_handle(&uut) == handles[3]);
+
+    iheap_destroy(&uut);
+
+    return 0;
+}
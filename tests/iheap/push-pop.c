@@ -0,0 +1,55 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "iheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct iheap uut;
+    size_t h;
+    int i;
+
+    assert(iheap_init(&uut, cmp, sizeof(int), 0, realloc) == 0);
+    assert(iheap_isempty(&uut));
+    assert(iheap_peek(&uut) == NULL);
+    assert(iheap_peek_handle(&uut) == IHEAP_NONE);
+    assert(iheap_pop(&uut) == -1);
+
+    /* Handles count up from 0, and each one refers to its own element. */
+    for (i = TEST_SIZE - 1; i >= 0; i--)
+    {
+        h = iheap_push(&uut, &i);
+        assert(h == (size_t)(TEST_SIZE - 1 - i));
+        assert(*(int *)iheap_get(&uut, h) == i);
+    }
+    assert(iheap_len(&uut) == TEST_SIZE);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        h = iheap_peek_handle(&uut);
+        assert(h == (size_t)(TEST_SIZE - 1 - i));
+        assert(*(int *)iheap_peek(&uut) == i);
+        assert(iheap_pop(&uut) == 0);
+        assert(!iheap_contains(&uut, h));
+    }
+    assert(iheap_isempty(&uut));
+
+    /* Freed handles are given out again instead of new ones. */
+    for (i = 0; i < TEST_SIZE; i++)
+        assert(iheap_push(&uut, &i) < TEST_SIZE);
+
+    iheap_destroy(&uut);
+
+    return 0;
+}
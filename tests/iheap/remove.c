@@ -0,0 +1,57 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "iheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct iheap uut;
+    size_t handles[TEST_SIZE];
+    int i, last;
+
+    assert(iheap_init(&uut, cmp, sizeof(int), TEST_SIZE, realloc) == 0);
+
+    /* Push in a scrambled order, so that removals move elements both up and
+     * down. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        int e = (i * 7919) % TEST_SIZE;
+        handles[e] = iheap_push(&uut, &e);
+    }
+
+    /* Remove every odd element by handle. */
+    for (i = 1; i < TEST_SIZE; i += 2)
+    {
+        iheap_remove(&uut, handles[i]);
+        assert(!iheap_contains(&uut, handles[i]));
+    }
+    assert(iheap_len(&uut) == TEST_SIZE / 2);
+
+    /* Removing the minimum is the same as popping it. */
+    iheap_remove(&uut, iheap_peek_handle(&uut));
+
+    last = 0;
+    while (!iheap_isempty(&uut))
+    {
+        i = *(int *)iheap_peek(&uut);
+        assert(i % 2 == 0 && i > last);
+        last = i;
+        iheap_pop(&uut);
+    }
+    assert(last == TEST_SIZE - 2);
+
+    iheap_destroy(&uut);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "mmheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 20000
+#endif
+
+#ifndef QUEUE_LEN
+#define QUEUE_LEN 64
+#endif
+
+#define MAX_KEY 1000
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    int counts[MAX_KEY];
+    struct mmheap uut;
+    int i, e, min, max;
+
+    memset(counts, 0, sizeof(counts));
+    srand(11);
+    assert(mmheap_init(&uut, cmp, sizeof(int), QUEUE_LEN + 1, realloc) == 0);
+
+    /* A bounded queue: when it is full, the worst entry is evicted. Every so
+     * often the best entry is taken off. Both ends must always match the
+     * reference counts. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        e = rand() % MAX_KEY;
+        assert(mmheap_push(&uut, &e) == 0);
+        counts[e]++;
+
+        if (mmheap_len(&uut) > QUEUE_LEN)
+        {
+            for (max = MAX_KEY - 1; counts[max] == 0; max--)
+                ;
+            assert(mmheap_pop_max(&uut, &e) == 0);
+            assert(e == max);
+            counts[e]--;
+        }
+
+        if (i % 5 == 0)
+        {
+            for (min = 0; counts[min] == 0; min++)
+                ;
+            assert(mmheap_pop_min(&uut, &e) == 0);
+            assert(e == min);
+            counts[e]--;
+        }
+    }
+
+    mmheap_destroy(&uut);
+
+    return 0;
+}
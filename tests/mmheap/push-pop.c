@@ -0,0 +1,67 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "mmheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct mmheap uut;
+    int lo, hi, i, e;
+
+    assert(mmheap_init(&uut, cmp, sizeof(int), 0, realloc) == 0);
+    assert(mmheap_peek_min(&uut) == NULL);
+    assert(mmheap_peek_max(&uut) == NULL);
+    assert(mmheap_pop_min(&uut, &e) == -1);
+    assert(mmheap_pop_max(&uut, &e) == -1);
+
+    /* Push a permutation of 0..TEST_SIZE-1. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        e = (i * 7919) % TEST_SIZE;
+        assert(mmheap_push(&uut, &e) == 0);
+    }
+    assert(mmheap_len(&uut) == TEST_SIZE);
+
+    /* Pop from both ends at once, so that both kinds of sift are used. */
+    lo = 0;
+    hi = TEST_SIZE - 1;
+    while (!mmheap_isempty(&uut))
+    {
+        assert(*(int *)mmheap_peek_min(&uut) == lo);
+        assert(*(int *)mmheap_peek_max(&uut) == hi);
+
+        if ((lo + hi) % 3 == 0)
+        {
+            assert(mmheap_pop_min(&uut, &e) == 0);
+            assert(e == lo++);
+        }
+        else
+        {
+            assert(mmheap_pop_max(&uut, &e) == 0);
+            assert(e == hi--);
+        }
+    }
+    assert(lo == hi + 1);
+
+    /* A single element is both the minimum and the maximum. */
+    e = 7;
+    mmheap_push(&uut, &e);
+    assert(mmheap_peek_min(&uut) == mmheap_peek_max(&uut));
+    assert(mmheap_pop_max(&uut, NULL) == 0);
+    assert(mmheap_isempty(&uut));
+
+    mmheap_destroy(&uut);
+
+    return 0;
+}
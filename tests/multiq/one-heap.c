@@ -0,0 +1,75 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "multiq.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 20000
+#endif
+
+#ifndef NUM_THREADS
+#define NUM_THREADS 4
+#endif
+
+struct worker
+{
+    struct multiq *mq;
+    pthread_t thread;
+    int id;
+};
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+/* With a single heap, every push contends for the same lock. */
+void *work(void *arg)
+{
+    struct worker *w = arg;
+    uint64_t seed = w->id + 1;
+    int i;
+
+    for (i = w->id; i < TEST_SIZE; i += NUM_THREADS)
+        assert(multiq_push(w->mq, &i, &seed) == 0);
+
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    static struct worker workers[NUM_THREADS];
+    struct multiq uut;
+    uint64_t seed = 99;
+    int i, e;
+
+    assert(multiq_init(&uut, cmp, sizeof(int), 1, realloc) == 0);
+
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        workers[i].mq = &uut;
+        workers[i].id = i;
+        assert(pthread_create(&workers[i].thread, NULL, work, &workers[i])
+                == 0);
+    }
+    for (i = 0; i < NUM_THREADS; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    /* A single heap pops in exact order. */
+    assert(multiq_len(&uut) == TEST_SIZE);
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(multiq_pop(&uut, &e, &seed) == 0);
+        assert(e == i);
+    }
+    assert(multiq_pop(&uut, &e, &seed) == -1);
+
+    multiq_destroy(&uut);
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "multiq.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 2048
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+int main(int argc, char *argv[])
+{
+    struct multiq uut;
+    uint64_t seed = 1;
+    char seen[TEST_SIZE];
+    int i, e;
+
+    /* With a single heap, the order is exact. */
+    assert(multiq_init(&uut, cmp, sizeof(int), 1, realloc) == 0);
+    assert(multiq_pop(&uut, &e, &seed) == -1);
+    for (i = TEST_SIZE - 1; i >= 0; i--)
+        assert(multiq_push(&uut, &i, &seed) == 0);
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(multiq_pop(&uut, &e, &seed) == 0);
+        assert(e == i);
+    }
+    assert(multiq_pop(&uut, &e, &seed) == -1);
+    multiq_destroy(&uut);
+
+    /* With many heaps, every element still comes out exactly once, even
+     * with a zero seed. */
+    seed = 0;
+    assert(multiq_init(&uut, cmp, sizeof(int), 16, realloc) == 0);
+    for (i = 0; i < TEST_SIZE; i++)
+        assert(multiq_push(&uut, &i, &seed) == 0);
+    assert(multiq_len(&uut) == TEST_SIZE);
+
+    memset(seen, 0, sizeof(seen));
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(multiq_pop(&uut, &e, &seed) == 0);
+        assert(e >= 0 && e < TEST_SIZE && !seen[e]);
+        seen[e] = 1;
+    }
+    assert(multiq_pop(&uut, &e, &seed) == -1);
+    assert(multiq_len(&uut) == 0);
+    multiq_destroy(&uut);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "multiq.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 20000
+#endif
+
+#ifndef NUM_THREADS
+#define NUM_THREADS 4
+#endif
+
+struct worker
+{
+    struct multiq *mq;
+    pthread_t thread;
+    int id;
+    int popped[TEST_SIZE];
+    int npopped;
+};
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return *_a - *_b;
+}
+
+/* Each worker pushes its own share of the elements, popping one after every
+ * other push. */
+void *work(void *arg)
+{
+    struct worker *w = arg;
+    uint64_t seed = w->id + 1;
+    int i, e;
+
+    for (i = w->id; i < TEST_SIZE; i += NUM_THREADS)
+    {
+        assert(multiq_push(w->mq, &i, &seed) == 0);
+        if (i % 2 == 1 && multiq_pop(w->mq, &e, &seed) == 0)
+            w->popped[w->npopped++] = e;
+    }
+
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    static struct worker workers[NUM_THREADS];
+    static char seen[TEST_SIZE];
+    struct multiq uut;
+    uint64_t seed = 99;
+    int i, j, e, total;
+
+    assert(multiq_init(&uut, cmp, sizeof(int), 2 * NUM_THREADS, realloc) == 0);
+
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        workers[i].mq = &uut;
+        workers[i].id = i;
+        workers[i].npopped = 0;
+        assert(pthread_create(&workers[i].thread, NULL, work, &workers[i])
+                == 0);
+    }
+
+    total = 0;
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_join(workers[i].thread, NULL);
+        for (j = 0; j < workers[i].npopped; j++)
+        {
+            e = workers[i].popped[j];
+            assert(!seen[e]);
+            seen[e] = 1;
+        }
+        total += workers[i].npopped;
+    }
+
+    /* Nothing was lost or duplicated. */
+    assert(multiq_len(&uut) == (size_t)(TEST_SIZE - total));
+    while (multiq_pop(&uut, &e, &seed) == 0)
+    {
+        assert(!seen[e]);
+        seen[e] = 1;
+        total++;
+    }
+    assert(total == TEST_SIZE);
+
+    multiq_destroy(&uut);
+
+    return 0;
+}
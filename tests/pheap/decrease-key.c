@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "list.h"
+#include "pheap.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif /* TEST_SIZE */
+
+struct uut_elem
+{
+    struct pheap_elem pe;
+    int n;
+};
+
+static struct uut_elem elems[TEST_SIZE];
+
+int cmp(const void *a, const void *b)
+{
+    const struct uut_elem *_a, *_b;
+
+    _a = containerof(a, struct uut_elem, pe);
+    _b = containerof(b, struct uut_elem, pe);
+
+    return _a->n - _b->n;
+}
+
+int main(int argc, char *argv[])
+{
+    struct uut_elem *cur;
+    struct pheap uut;
+    int i, j, prev;
+
+    pheap_init(&uut, cmp);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        pheap_elem_init(&elems[i].pe);
+        elems[i].n = TEST_SIZE + rand() % TEST_SIZE;
+        pheap_push(&uut, &elems[i].pe);
+    }
+
+    /* Pop once, so that the heap has some structure below the root. */
+    cur = containerof(pheap_pop(&uut), struct uut_elem, pe);
+    cur->n = -1;
+
+    /* Decrease keys at random, including some that become the new minimum
+     * and some that decrease the root itself. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        j = rand() % TEST_SIZE;
+        if (elems[j].n < 0)
+            continue;
+
+        elems[j].n -= rand() % (elems[j].n + 1);
+        pheap_decrease_key(&uut, &elems[j].pe);
+
+        cur = containerof(pheap_peek(&uut), struct uut_elem, pe);
+        assert(cur->n <= elems[j].n);
+    }
+
+    pheap_decrease_key(&uut, pheap_peek(&uut));
+
+    /* Everything must still come out in order. */
+    prev = -1;
+    for (i = 0; i < TEST_SIZE - 1; i++)
+    {
+        assert(!pheap_isempty(&uut));
+        cur = containerof(pheap_pop(&uut), struct uut_elem, pe);
+        assert(cur->n >= prev);
+        prev = cur->n;
+    }
+    assert(pheap_isempty(&uut));
+
+    return 0;
+}
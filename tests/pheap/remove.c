@@ -0,0 +1,74 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "list.h"
+#include "pheap.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif /* TEST_SIZE */
+
+struct uut_elem
+{
+    struct pheap_elem pe;
+    int n;
+};
+
+static struct uut_elem elems[TEST_SIZE];
+
+int cmp(const void *a, const void *b)
+{
+    const struct uut_elem *_a, *_b;
+
+    _a = containerof(a, struct uut_elem, pe);
+    _b = containerof(b, struct uut_elem, pe);
+
+    return _a->n - _b->n;
+}
+
+int main(int argc, char *argv[])
+{
+    struct uut_elem *cur;
+    struct pheap uut;
+    int i;
+
+    pheap_init(&uut, cmp);
+
+    /* Element i has the key (i * 7919) % TEST_SIZE, so each key is used
+     * once. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        pheap_elem_init(&elems[i].pe);
+        elems[i].n = (i * 7919) % TEST_SIZE;
+        pheap_push(&uut, &elems[i].pe);
+    }
+
+    /* Pop a few, so that there are nodes with children below the root. */
+    for (i = 0; i < 4; i++)
+        assert(containerof(pheap_pop(&uut), struct uut_elem, pe)->n == i);
+
+    /* Remove every element with an odd key, including the root when it is
+     * odd. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        if (elems[i].n % 2 == 1 && elems[i].n >= 4)
+            pheap_remove(&uut, &elems[i].pe);
+    }
+
+    for (i = 4; i < TEST_SIZE; i += 2)
+    {
+        assert(!pheap_isempty(&uut));
+        cur = containerof(pheap_pop(&uut), struct uut_elem, pe);
+        assert(cur->n == i);
+    }
+    assert(pheap_isempty(&uut));
+
+    /* Removing the only element empties the heap. */
+    pheap_elem_init(&elems[0].pe);
+    pheap_push(&uut, &elems[0].pe);
+    pheap_remove(&uut, &elems[0].pe);
+    assert(pheap_isempty(&uut));
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "radixheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 20000
+#endif
+
+/* Reference: the number of pushed keys at each value still on the heap. */
+#define MAX_KEY (TEST_SIZE + 1000)
+
+int main(int argc, char *argv[])
+{
+    static int counts[MAX_KEY];
+    struct radixheap uut;
+    uint64_t key, last, min;
+    int i, k;
+
+    assert(radixheap_init(&uut, sizeof(uint64_t), realloc) == 0);
+
+    /* Simulate events: each pop schedules a few new events a little later,
+     * like Dijkstra relaxing the edges of a vertex. */
+    last = 0;
+    assert(radixheap_push(&uut, 0, &last) == 0);
+    counts[0]++;
+
+    for (i = 0; i < TEST_SIZE && !radixheap_isempty(&uut); i++)
+    {
+        assert(radixheap_pop(&uut, &key, &min) == 0);
+        assert(key == min);
+
+        /* The popped key must be the smallest one on the heap. */
+        for (min = last; counts[min] == 0; min++)
+            ;
+        assert(key == min);
+        counts[key]--;
+        last = key;
+
+        for (k = rand() % 3; k >= 0; k--)
+        {
+            key = last + rand() % 1000;
+            if (key < MAX_KEY)
+            {
+                assert(radixheap_push(&uut, key, &key) == 0);
+                counts[key]++;
+            }
+        }
+    }
+
+    radixheap_destroy(&uut);
+
+    return 0;
+}
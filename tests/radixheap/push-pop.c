@@ -0,0 +1,52 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "radixheap.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 4096
+#endif
+
+int main(int argc, char *argv[])
+{
+    struct radixheap uut;
+    uint64_t key, last;
+    int i, val;
+
+    assert(radixheap_init(&uut, sizeof(int), realloc) == 0);
+    assert(radixheap_isempty(&uut));
+    assert(radixheap_pop(&uut, &key, &val) == -1);
+    assert(radixheap_peek(&uut, &key) == NULL);
+
+    /* Keys spread over the whole 64-bit range, so that every bucket is
+     * used. The payload is the index of the key. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        key = (uint64_t)rand() << 40 ^ (uint64_t)rand() << 20 ^ rand();
+        key >>= i % 64;
+        assert(radixheap_push(&uut, key, &i) == 0);
+    }
+    assert(radixheap_len(&uut) == TEST_SIZE);
+
+    last = 0;
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(*(int *)radixheap_peek(&uut, &key) >= 0);
+        assert(key >= last);
+        assert(radixheap_pop(&uut, &key, &val) == 0);
+        assert(key >= last);
+        assert(val >= 0 && val < TEST_SIZE);
+        assert(key <= (UINT64_MAX >> (val % 64)));
+        last = key;
+    }
+    assert(radixheap_isempty(&uut));
+
+    /* Keys equal to the last one popped are still allowed. */
+    assert(radixheap_push(&uut, last, &i) == 0);
+    assert(radixheap_pop(&uut, &key, NULL) == 0);
+    assert(key == last);
+
+    radixheap_destroy(&uut);
+
+    return 0;
+}
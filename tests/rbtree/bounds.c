@@ -0,0 +1,99 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "rbtree.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+/* Every key is a multiple of STEP, and is used DUPS times. */
+#define STEP 4
+#define DUPS 3
+
+struct uut_node
+{
+    struct rbnode rbn;
+    unsigned n;
+};
+
+static int cmp(const void *_a, const void *_b)
+{
+    struct uut_node *a, *b;
+
+    a = containerof(_a, struct uut_node, rbn);
+    b = containerof(_b, struct uut_node, rbn);
+
+    return a->n - b->n;
+}
+
+static unsigned key_of(const struct rbnode *node)
+{
+    return containerof(node, struct uut_node, rbn)->n;
+}
+
+int main(int argc, char *argv[])
+{
+    static struct uut_node nodes[TEST_SIZE * DUPS];
+    const unsigned max = (TEST_SIZE - 1) * STEP;
+    struct uut_node key;
+    struct rbnode *node;
+    struct rbtree tree;
+    struct rbiter it;
+    unsigned lo, hi;
+    size_t i, count;
+
+    rbtree_init(&tree, cmp);
+
+    for (i = 0; i < TEST_SIZE * DUPS; i++)
+    {
+        nodes[i].n = ((i * 7919) % TEST_SIZE) * STEP;
+        rbtree_insert(&tree, &nodes[i].rbn);
+    }
+
+    for (key.n = 0; key.n <= max + STEP; key.n++)
+    {
+        /* The lower bound is the first of the duplicates, so the node before
+         * it is smaller. */
+        node = rbtree_lower_bound(&tree, &key.rbn, &it);
+        if (key.n > max)
+        {
+            assert(node == NULL);
+        }
+        else
+        {
+            assert(key_of(node) == (key.n + STEP - 1) / STEP * STEP);
+            node = rbtree_prev(&it);
+            assert(node == NULL || key_of(node) < key.n);
+        }
+
+        /* The upper bound skips all the duplicates. */
+        node = rbtree_upper_bound(&tree, &key.rbn, &it);
+        if (key.n >= max)
+        {
+            assert(node == NULL);
+        }
+        else
+        {
+            assert(key_of(node) == key.n / STEP * STEP + STEP);
+            node = rbtree_prev(&it);
+            assert(key_of(node) <= key.n);
+        }
+    }
+
+    /* Scan a range [lo, hi) and count the nodes in it. */
+    lo = 10 * STEP + 1;
+    hi = 20 * STEP;
+    key.n = lo;
+    count = 0;
+    for (node = rbtree_lower_bound(&tree, &key.rbn, &it);
+            node != NULL && key_of(node) < hi; node = rbtree_next(&it))
+    {
+        assert(key_of(node) >= lo);
+        count++;
+    }
+    assert(count == 9 * DUPS);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "rbtree.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+struct uut_node
+{
+    struct rbnode rbn;
+    unsigned n;
+};
+
+static int cmp(const void *_a, const void *_b)
+{
+    struct uut_node *a, *b;
+
+    a = containerof(_a, struct uut_node, rbn);
+    b = containerof(_b, struct uut_node, rbn);
+
+    return a->n - b->n;
+}
+
+static int _count(const struct rbnode *_node, void *_count)
+{
+    const struct uut_node *node = containerof(_node, struct uut_node, rbn);
+    size_t *count = _count;
+
+    /* Only the odd keys are left. */
+    assert(node->n % 2 == 1);
+    (*count)++;
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static struct uut_node nodes[TEST_SIZE];
+    struct rbtree tree;
+    struct uut_node key;
+    struct rbnode *del;
+    size_t i, count;
+
+    rbtree_init(&tree, cmp);
+
+    /* Each key is used once, inserted in a scattered order. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        nodes[i].n = (i * 7919) % TEST_SIZE;
+        rbtree_insert(&tree, &nodes[i].rbn);
+    }
+
+    /* Delete the even keys, in a different scattered order. The tree is
+     * checked for consistency after each removal. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        key.n = (i * 104729) % TEST_SIZE;
+        if (key.n % 2 == 1)
+            continue;
+
+        del = rbtree_delete(&tree, &key.rbn);
+        assert(del != NULL);
+        assert(containerof(del, struct uut_node, rbn)->n == key.n);
+        assert(rbtree_search(&tree, &key.rbn) == NULL);
+        assert(rbtree_delete(&tree, &key.rbn) == NULL);
+    }
+
+    count = 0;
+    rbtree_traverse(&tree, _count, &count);
+    assert(count == TEST_SIZE / 2);
+
+    /* Churn: delete and reinsert every remaining key. */
+    for (i = 1; i < TEST_SIZE; i += 2)
+    {
+        key.n = i;
+        del = rbtree_delete(&tree, &key.rbn);
+        assert(del != NULL);
+        rbtree_insert(&tree, del);
+        assert(rbtree_search(&tree, &key.rbn) == del);
+    }
+
+    /* Delete everything else, in ascending order. */
+    for (i = 1; i < TEST_SIZE; i += 2)
+    {
+        key.n = i;
+        assert(rbtree_delete(&tree, &key.rbn) != NULL);
+    }
+    assert(tree.root == NULL);
+
+    return 0;
+}
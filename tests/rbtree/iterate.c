@@ -0,0 +1,82 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "rbtree.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+struct uut_node
+{
+    struct rbnode rbn;
+    unsigned n;
+};
+
+static int cmp(const void *_a, const void *_b)
+{
+    struct uut_node *a, *b;
+
+    a = containerof(_a, struct uut_node, rbn);
+    b = containerof(_b, struct uut_node, rbn);
+
+    return a->n - b->n;
+}
+
+int main(int argc, char *argv[])
+{
+    static struct uut_node nodes[TEST_SIZE];
+    struct uut_node *cur;
+    struct rbnode *node;
+    struct rbtree tree;
+    struct rbiter it;
+    size_t i;
+
+    rbtree_init(&tree, cmp);
+
+    /* Nothing to iterate over in an empty tree. */
+    assert(rbtree_first(&tree, &it) == NULL);
+    assert(rbtree_next(&it) == NULL);
+    assert(rbtree_last(&tree, &it) == NULL);
+    assert(rbtree_prev(&it) == NULL);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        nodes[i].n = (i * 7919) % TEST_SIZE;
+        rbtree_insert(&tree, &nodes[i].rbn);
+    }
+
+    /* Forwards, every key appears once, in order. */
+    i = 0;
+    for (node = rbtree_first(&tree, &it); node != NULL; node = rbtree_next(&it))
+    {
+        cur = containerof(node, struct uut_node, rbn);
+        assert(cur->n == i);
+        i++;
+    }
+    assert(i == TEST_SIZE);
+    assert(rbtree_next(&it) == NULL);
+
+    /* Backwards as well. */
+    i = TEST_SIZE;
+    for (node = rbtree_last(&tree, &it); node != NULL; node = rbtree_prev(&it))
+    {
+        i--;
+        cur = containerof(node, struct uut_node, rbn);
+        assert(cur->n == i);
+    }
+    assert(i == 0);
+
+    /* Change direction in the middle. */
+    node = rbtree_first(&tree, &it);
+    for (i = 0; i < TEST_SIZE / 2; i++)
+        node = rbtree_next(&it);
+    assert(containerof(node, struct uut_node, rbn)->n == TEST_SIZE / 2);
+    node = rbtree_prev(&it);
+    assert(containerof(node, struct uut_node, rbn)->n == TEST_SIZE / 2 - 1);
+    node = rbtree_next(&it);
+    assert(containerof(node, struct uut_node, rbn)->n == TEST_SIZE / 2);
+
+    return 0;
+}
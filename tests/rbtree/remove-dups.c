@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "rbtree.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+/* Number of distinct keys; every key is used many times. */
+#define NKEYS 8
+
+struct uut_node
+{
+    struct rbnode rbn;
+    unsigned n;
+    int removed;
+};
+
+static int cmp(const void *_a, const void *_b)
+{
+    struct uut_node *a, *b;
+
+    a = containerof(_a, struct uut_node, rbn);
+    b = containerof(_b, struct uut_node, rbn);
+
+    return a->n - b->n;
+}
+
+static int _check(const struct rbnode *_node, void *_prev)
+{
+    const struct uut_node *node = containerof(_node, struct uut_node, rbn);
+    int *prev = _prev;
+
+    assert(!node->removed);
+    assert((int)node->n >= *prev);
+    *prev = node->n;
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static struct uut_node nodes[TEST_SIZE];
+    struct rbtree tree;
+    size_t i, j;
+    int prev;
+
+    rbtree_init(&tree, cmp);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        nodes[i].n = rand() % NKEYS;
+        nodes[i].removed = 0;
+        rbtree_insert(&tree, &nodes[i].rbn);
+    }
+
+    /* Remove random nodes; each must be found among its duplicates. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        j = rand() % TEST_SIZE;
+        if (nodes[j].removed)
+        {
+            assert(rbtree_remove(&tree, &nodes[j].rbn) == -1);
+            continue;
+        }
+
+        assert(rbtree_remove(&tree, &nodes[j].rbn) == 0);
+        nodes[j].removed = 1;
+    }
+
+    prev = 0;
+    rbtree_traverse(&tree, _check, &prev);
+
+    /* Removing the remaining nodes empties the tree. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        if (!nodes[i].removed)
+            assert(rbtree_remove(&tree, &nodes[i].rbn) == 0);
+    }
+    assert(tree.root == NULL);
+
+    return 0;
+}
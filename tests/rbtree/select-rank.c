@@ -0,0 +1,122 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "rbtree.h"
+#include "utils.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+struct uut_node
+{
+    struct rbosnode osn;
+    unsigned n;
+    int removed;
+};
+
+static struct uut_node nodes[TEST_SIZE];
+
+static int cmp(const void *_a, const void *_b)
+{
+    struct uut_node *a, *b;
+
+    a = containerof(_a, struct uut_node, osn.rbn);
+    b = containerof(_b, struct uut_node, osn.rbn);
+
+    return a->n - b->n;
+}
+
+/* Check select and rank against the nodes that are still in the tree. Keys are
+ * in [0, TEST_SIZE), with duplicates. */
+static void check(const struct rbtree *tree, size_t len)
+{
+    size_t counts[TEST_SIZE + 1] = { 0 };
+    struct uut_node key, *cur;
+    size_t i, below;
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        if (!nodes[i].removed)
+            counts[nodes[i].n]++;
+    }
+
+    assert(rbtree_size(tree) == len);
+    assert(rbtree_select(tree, len) == NULL);
+
+    below = 0;
+    for (key.n = 0; key.n <= TEST_SIZE; key.n++)
+    {
+        assert(rbtree_rank(tree, &key.osn.rbn) == below);
+
+        /* Every rank among the duplicates selects a node with this key. */
+        for (i = below; i < below + counts[key.n]; i++)
+        {
+            cur = containerof(rbtree_select(tree, i), struct uut_node, osn.rbn);
+            assert(cur->n == key.n);
+        }
+
+        below += counts[key.n];
+    }
+    assert(below == len);
+}
+
+int main(int argc, char *argv[])
+{
+    struct rbtree tree;
+    struct uut_node key;
+    struct rbnode *node;
+    size_t i, len;
+
+    rbtree_init_os(&tree, cmp);
+
+    for (i = 0; i < TEST_SIZE; i++)
+        nodes[i].removed = 1;
+    check(&tree, 0);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        nodes[i].n = rand() % (TEST_SIZE / 4);
+        nodes[i].removed = 0;
+        rbtree_insert(&tree, &nodes[i].osn.rbn);
+    }
+    len = TEST_SIZE;
+    check(&tree, len);
+
+    /* Remove a quarter of the nodes by identity. */
+    for (i = 0; i < TEST_SIZE; i += 4)
+    {
+        assert(rbtree_remove(&tree, &nodes[i].osn.rbn) == 0);
+        nodes[i].removed = 1;
+        len--;
+    }
+    check(&tree, len);
+
+    /* Delete another quarter by key. */
+    for (i = 0; i < TEST_SIZE / 4; i++)
+    {
+        key.n = rand() % (TEST_SIZE / 4);
+        node = rbtree_delete(&tree, &key.osn.rbn);
+        if (node == NULL)
+            continue;
+
+        containerof(node, struct uut_node, osn.rbn)->removed = 1;
+        len--;
+    }
+    check(&tree, len);
+
+    /* Put everything back with new keys. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        if (!nodes[i].removed)
+            continue;
+
+        nodes[i].n = rand() % TEST_SIZE;
+        nodes[i].removed = 0;
+        rbtree_insert(&tree, &nodes[i].osn.rbn);
+        len++;
+    }
+    check(&tree, len);
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "segvec.h"
+
+static void check(void *e, size_t i, void *scratch)
+{
+    assert(*(size_t *)e == i);
+    (*(size_t *)scratch)++;
+}
+
+int main(int argc, char *argv[])
+{
+    struct segvec sv;
+    size_t i, n;
+
+    segvec_init(&sv, sizeof(size_t), realloc);
+
+    /* Fill exactly the first three chunks. */
+    for (i = 0; i < 7 * SEGVEC_BASE; i++)
+        segvec_push(&sv, &i);
+    assert(sv.nchunks == 3);
+    assert(segvec_space(&sv) == 7 * SEGVEC_BASE);
+
+    n = 0;
+    segvec_map(&sv, check, &n);
+    assert(n == 7 * SEGVEC_BASE);
+
+    /* Popping into the second chunk frees only the third. */
+    while (segvec_len(&sv) > 3 * SEGVEC_BASE - 1)
+        assert(segvec_pop(&sv) == 0);
+    segvec_shrink(&sv);
+    assert(sv.nchunks == 2);
+    assert(*(size_t *)segvec_get(&sv, 3 * SEGVEC_BASE - 2)
+            == 3 * SEGVEC_BASE - 2);
+
+    while (!segvec_isempty(&sv))
+        segvec_pop(&sv);
+    assert(segvec_pop(&sv) == -1);
+    segvec_shrink(&sv);
+    assert(sv.nchunks == 0);
+
+    segvec_destroy(&sv);
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "segvec.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 100000
+#endif
+
+static int *ptrs[TEST_SIZE];
+
+int main(int argc, char *argv[])
+{
+    struct segvec sv;
+    int i;
+
+    segvec_init(&sv, sizeof(int), realloc);
+    assert(segvec_isempty(&sv));
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(segvec_push(&sv, &i) == 0);
+        ptrs[i] = segvec_get(&sv, i);
+    }
+    assert(segvec_len(&sv) == TEST_SIZE);
+    assert(segvec_space(&sv) >= TEST_SIZE);
+
+    /* Growing the vector never moved any of the elements. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(segvec_get(&sv, i) == ptrs[i]);
+        assert(*ptrs[i] == i);
+    }
+
+    segvec_destroy(&sv);
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "topk.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 10000
+#endif
+
+#ifndef TEST_K
+#define TEST_K 100
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+int main(int argc, char *argv[])
+{
+    struct topk batch, single;
+    int *data;
+    int a[TEST_K], b[TEST_K];
+    int i;
+
+    data = malloc(TEST_SIZE * sizeof(int));
+    assert(data != NULL);
+
+    srand(3);
+    for (i = 0; i < TEST_SIZE; i++)
+        data[i] = rand() % 5000;
+
+    assert(topk_init(&batch, cmp, sizeof(int), TEST_K, realloc) == 0);
+    assert(topk_init(&single, cmp, sizeof(int), TEST_K, realloc) == 0);
+
+    /* Offer the array in uneven batches; the first one does not fill the
+     * selector. */
+    assert(topk_offer_n(&batch, data, 10) == 10);
+    topk_offer_n(&batch, data + 10, 990);
+    topk_offer_n(&batch, data + 1000, TEST_SIZE - 1000);
+    topk_offer_n(&batch, NULL, 0);
+
+    for (i = 0; i < TEST_SIZE; i++)
+        topk_offer(&single, &data[i]);
+
+    /* Both ways must keep the same elements. */
+    assert(topk_drain(&batch, a) == TEST_K);
+    assert(topk_drain(&single, b) == TEST_K);
+    for (i = 0; i < TEST_K; i++)
+    {
+        assert(a[i] == b[i]);
+        assert(i == 0 || a[i] <= a[i - 1]);
+    }
+
+    /* Sorting the data gives the same answer. */
+    qsort(data, TEST_SIZE, sizeof(int), cmp);
+    for (i = 0; i < TEST_K; i++)
+        assert(a[i] == data[TEST_SIZE - 1 - i]);
+
+    topk_destroy(&batch);
+    topk_destroy(&single);
+    free(data);
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "topk.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 4096
+#endif
+
+#ifndef TEST_K
+#define TEST_K 16
+#endif
+
+int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+int main(int argc, char *argv[])
+{
+    struct topk uut;
+    int out[TEST_K];
+    int i, e;
+
+    assert(topk_init(&uut, cmp, sizeof(int), TEST_K, realloc) == 0);
+    assert(topk_peek(&uut) == NULL);
+
+    /* Offer a permutation of 0..TEST_SIZE-1. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        e = (i * 7919) % TEST_SIZE;
+        assert(topk_offer(&uut, &e) >= 0);
+        assert(topk_len(&uut) <= TEST_K);
+    }
+    assert(topk_isfull(&uut));
+    assert(*(int *)topk_peek(&uut) == TEST_SIZE - TEST_K);
+
+    /* Anything no bigger than the smallest kept element is rejected. */
+    e = TEST_SIZE - TEST_K;
+    assert(topk_offer(&uut, &e) == 0);
+    e = TEST_SIZE;
+    assert(topk_offer(&uut, &e) == 1);
+    assert(*(int *)topk_peek(&uut) == TEST_SIZE - TEST_K + 1);
+
+    /* Draining gives the largest first. */
+    assert(topk_drain(&uut, out) == TEST_K);
+    for (i = 0; i < TEST_K; i++)
+        assert(out[i] == TEST_SIZE - i);
+    assert(topk_len(&uut) == 0);
+
+    topk_destroy(&uut);
+
+    /* Keeping nothing rejects everything. */
+    assert(topk_init(&uut, cmp, sizeof(int), 0, realloc) == 0);
+    assert(topk_offer(&uut, &e) == 0);
+    assert(topk_offer_n(&uut, out, TEST_K) == 0);
+    assert(topk_len(&uut) == 0);
+    topk_destroy(&uut);
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vecaligned.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 10000
+#endif
+
+#ifndef TEST_ALIGN
+#define TEST_ALIGN 64
+#endif
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int i;
+
+    assert(vec_init_aligned(&v, sizeof(int), 3, TEST_ALIGN, 0) == 0);
+    assert((uintptr_t)v.data % TEST_ALIGN == 0);
+
+    /* The buffer stays aligned, and keeps its contents, as it grows. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        vec_push(&v, &i);
+        assert((uintptr_t)v.data % TEST_ALIGN == 0);
+    }
+    for (i = 0; i < TEST_SIZE; i++)
+        assert(*(int *)vec_get(&v, i) == i);
+
+    vec_erase_range(&v, 10, TEST_SIZE - 10);
+    vec_shrink(&v);
+    assert((uintptr_t)v.data % TEST_ALIGN == 0);
+    for (i = 0; i < 10; i++)
+        assert(*(int *)vec_get(&v, i) == i);
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "vecaligned.h"
+#include "vector.h"
+
+#define TEST_SIZE (3 * VEC_HUGEPAGE_MIN / sizeof(size_t))
+
+/* Map a page right after the vector's buffer, so that the buffer cannot grow
+ * in place and its pages have to be moved. Returns NULL if the page could not
+ * be placed there. */
+static void *block_growth(const struct vector *v)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *end;
+    void *p;
+
+    end = v->data + vec_space(v) * v->elemsize;
+    end += (page - (uintptr_t)end % page) % page;
+
+    p = mmap(end, page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        return NULL;
+    if (p != end)
+    {
+        munmap(p, page);
+        return NULL;
+    }
+
+    return p;
+}
+
+static void check_growth(size_t align)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t want = align > VEC_HUGEPAGE_MIN ? align : VEC_HUGEPAGE_MIN;
+    struct vector v;
+    void *blocker;
+    size_t i, round;
+
+    assert(vec_init_aligned(&v, sizeof(size_t), 0, align, VEC_HUGEPAGE) == 0);
+    for (i = 0; i < TEST_SIZE; i++)
+        vec_push(&v, &i);
+    assert((uintptr_t)v.data % want == 0);
+
+    /* Grow a few times, with and without room to grow in place. */
+    for (round = 1; round <= 4; round++)
+    {
+        blocker = (round % 2 == 1) ? block_growth(&v) : NULL;
+
+        assert(vec_reserve(&v, (round + 1) * TEST_SIZE) == 0);
+        assert((uintptr_t)v.data % want == 0);
+        for (i = 0; i < TEST_SIZE; i++)
+            assert(*(size_t *)vec_get(&v, i) == i);
+
+        if (blocker != NULL)
+            munmap(blocker, page);
+    }
+
+    vec_destroy(&v);
+}
+
+int main(int argc, char *argv[])
+{
+    /* Huge page buffers stay on huge page boundaries, and on the vector's own
+     * boundaries when those are bigger. */
+    check_growth(32);
+    check_growth(4 * VEC_HUGEPAGE_MIN);
+
+    return 0;
+}
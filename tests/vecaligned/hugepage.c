@@ -0,0 +1,36 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vecaligned.h"
+#include "vector.h"
+
+#define TEST_SIZE (3 * VEC_HUGEPAGE_MIN / sizeof(size_t))
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    size_t i;
+
+    assert(vec_init_aligned(&v, sizeof(size_t), 0, 32, VEC_HUGEPAGE) == 0);
+
+    /* Grow from a small heap buffer through several mapped buffers. */
+    for (i = 0; i < TEST_SIZE; i++)
+        vec_push(&v, &i);
+    assert((uintptr_t)v.data % 32 == 0);
+    for (i = 0; i < TEST_SIZE; i++)
+        assert(*(size_t *)vec_get(&v, i) == i);
+
+    /* Reserve straight into a mapping, then shrink back onto the heap. */
+    assert(vec_reserve(&v, 2 * TEST_SIZE) == 0);
+    vec_erase_range(&v, 100, TEST_SIZE - 100);
+    assert(vec_shrink(&v) == 0);
+    assert(vec_space(&v) == 100);
+    assert((uintptr_t)v.data % 32 == 0);
+    for (i = 0; i < 100; i++)
+        assert(*(size_t *)vec_get(&v, i) == i);
+
+    vec_destroy(&v);
+
+    return 0;
+}
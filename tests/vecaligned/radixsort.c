@@ -0,0 +1,34 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vecaligned.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1000
+#endif
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    uint32_t k;
+    size_t i;
+
+    /* An aligned vector has no general allocator, but can still be sorted. */
+    assert(vec_init_aligned(&v, sizeof(uint32_t), 0, 64, 0) == 0);
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        k = (uint32_t)((TEST_SIZE - i) * 2654435761u);
+        vec_push(&v, &k);
+    }
+
+    assert(vec_radixsort(&v, 0, sizeof(uint32_t)) == 0);
+    assert((uintptr_t)v.data % 64 == 0);
+    for (i = 1; i < TEST_SIZE; i++)
+        assert(*(uint32_t *)vec_get(&v, i - 1) <= *(uint32_t *)vec_get(&v, i));
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "vecfile.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 100000
+#endif
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    char path[] = "/tmp/vector-file-XXXXXX";
+    long i;
+    int fd;
+
+    fd = mkstemp(path);
+    assert(fd != -1);
+    close(fd);
+
+    /* Fill a new file, growing it several times along the way. */
+    assert(vec_open(&v, sizeof(long), path) == 0);
+    assert(vec_isempty(&v));
+    for (i = 0; i < TEST_SIZE; i++)
+        vec_push(&v, &i);
+    assert(vec_sync(&v) == 0);
+    vec_destroy(&v);
+
+    /* Opening it again gives back the same vector. */
+    assert(vec_open(&v, sizeof(long), path) == 0);
+    assert(vec_len(&v) == TEST_SIZE);
+    for (i = 0; i < TEST_SIZE; i++)
+        assert(*(long *)vec_get(&v, i) == i);
+
+    /* Shrinking truncates the file; the length is saved on destroy too. */
+    vec_erase_range(&v, 10, TEST_SIZE - 10);
+    assert(vec_shrink(&v) == 0);
+    assert(vec_space(&v) == 10);
+    vec_destroy(&v);
+
+    assert(vec_open(&v, sizeof(long), path) == 0);
+    assert(vec_len(&v) == 10);
+    assert(*(long *)vec_tail(&v) == 9);
+    vec_destroy(&v);
+
+    /* The element size has to match the file. */
+    assert(vec_open(&v, sizeof(char), path) == -1);
+
+    unlink(path);
+
+    return 0;
+}
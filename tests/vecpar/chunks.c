@@ -0,0 +1,92 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vecpar.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 100003
+#endif
+
+/* An element size that does not divide the cache line, so that chunk
+ * boundaries depend on where the buffer starts. */
+struct elem
+{
+    long n[3];
+};
+
+/* Bytes before each buffer: its size, then padding so that the buffer starts
+ * 16 bytes past a cache line. */
+#define HEADER (VECPAR_CACHE_LINE + 16)
+
+static pthread_t owners[TEST_SIZE];
+
+/* Allocator whose buffers are only 16-byte aligned, never cache line aligned,
+ * like large blocks from many malloc implementations. */
+static void *misaligned(void *ptr, size_t size)
+{
+    char *old = ptr != NULL ? (char *)ptr - HEADER : NULL;
+    void *block;
+    size_t oldsize;
+
+    if (size == 0)
+    {
+        free(old);
+        return NULL;
+    }
+
+    if (posix_memalign(&block, VECPAR_CACHE_LINE, size + HEADER) != 0)
+        return NULL;
+
+    if (old != NULL)
+    {
+        memcpy(&oldsize, old, sizeof(oldsize));
+        memcpy((char *)block + HEADER, ptr, oldsize < size ? oldsize : size);
+        free(old);
+    }
+    memcpy(block, &size, sizeof(size));
+
+    return (char *)block + HEADER;
+}
+
+static void mark(void *e, size_t i, void *scratch)
+{
+    owners[i] = pthread_self();
+}
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    struct elem e = { { 0 } };
+    unsigned nthreads;
+    uintptr_t addr;
+    size_t i;
+
+    vec_init(&v, sizeof(e), 0, misaligned);
+    for (i = 0; i < TEST_SIZE; i++)
+        vec_push(&v, &e);
+    assert((uintptr_t)vec_get(&v, 0) % VECPAR_CACHE_LINE != 0);
+
+    for (nthreads = 2; nthreads <= 8; nthreads *= 2)
+    {
+        vec_pmap(&v, mark, NULL, nthreads);
+
+        /* An element that does not start a cache line shares it with the
+         * element before, so both must have been handled by one thread. */
+        for (i = 1; i < TEST_SIZE; i++)
+        {
+            addr = (uintptr_t)vec_get(&v, i);
+            if (addr % VECPAR_CACHE_LINE != 0)
+                assert(pthread_equal(owners[i], owners[i-1]));
+        }
+    }
+
+    vec_destroy(&v);
+
+    return 0;
+}
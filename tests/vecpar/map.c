@@ -0,0 +1,42 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vecpar.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 100003
+#endif
+
+static void square(void *e, size_t i, void *scratch)
+{
+    long *n = e;
+
+    assert((size_t)*n == i);
+    *n = *n * *n;
+}
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    unsigned nthreads;
+    long i;
+
+    vec_init(&v, sizeof(long), 0, realloc);
+
+    for (nthreads = 1; nthreads <= 8; nthreads *= 2)
+    {
+        vec_erase_range(&v, 0, vec_len(&v));
+        for (i = 0; i < TEST_SIZE; i++)
+            vec_push(&v, &i);
+
+        vec_pmap(&v, square, NULL, nthreads);
+
+        for (i = 0; i < TEST_SIZE; i++)
+            assert(*(long *)vec_get(&v, i) == i * i);
+    }
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vecpar.h"
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 100003
+#endif
+
+static void add(void *acc, const void *e, size_t i, void *scratch)
+{
+    *(long *)acc += *(const int *)e;
+}
+
+static void combine(void *acc, const void *other, void *scratch)
+{
+    *(long *)acc += *(const long *)other;
+}
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    unsigned nthreads;
+    long sum;
+    int i;
+
+    vec_init(&v, sizeof(int), 0, realloc);
+    for (i = 0; i < TEST_SIZE; i++)
+        vec_push(&v, &i);
+
+    sum = 0;
+    vec_reduce(&v, &sum, add, NULL);
+    assert(sum == (long)TEST_SIZE * (TEST_SIZE - 1) / 2);
+
+    for (nthreads = 1; nthreads <= 8; nthreads++)
+    {
+        sum = 0;
+        assert(vec_preduce(&v, &sum, sizeof(sum), add, combine, NULL,
+                    nthreads) == 0);
+        assert(sum == (long)TEST_SIZE * (TEST_SIZE - 1) / 2);
+    }
+
+    /* An empty vector reduces to the identity. */
+    vec_erase_range(&v, 0, vec_len(&v));
+    sum = 0;
+    assert(vec_preduce(&v, &sum, sizeof(sum), add, combine, NULL, 4) == 0);
+    assert(sum == 0);
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+static int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int src[] = { 1, 3, 3, 3, 5, 8 };
+    int key;
+
+    vec_init(&v, sizeof(int), 0, realloc);
+
+    key = 3;
+    assert(vec_lower_bound(&v, &key, cmp) == 0);
+    assert(vec_upper_bound(&v, &key, cmp) == 0);
+
+    vec_extend(&v, src, 6);
+
+    assert(vec_lower_bound(&v, &key, cmp) == 1);
+    assert(vec_upper_bound(&v, &key, cmp) == 4);
+
+    key = 0;
+    assert(vec_lower_bound(&v, &key, cmp) == 0);
+    assert(vec_upper_bound(&v, &key, cmp) == 0);
+
+    key = 6;
+    assert(vec_lower_bound(&v, &key, cmp) == 5);
+    assert(vec_upper_bound(&v, &key, cmp) == 5);
+
+    key = 9;
+    assert(vec_lower_bound(&v, &key, cmp) == 6);
+    assert(vec_upper_bound(&v, &key, cmp) == 6);
+
+    vec_destroy(&v);
+
+    return 0;
+}
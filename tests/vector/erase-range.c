@@ -0,0 +1,35 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int src[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    vec_init(&v, sizeof(int), 0, realloc);
+    vec_extend(&v, src, 8);
+
+    /* Erase from the middle. */
+    vec_erase_range(&v, 2, 3);
+    assert(vec_len(&v) == 5);
+    assert(*(int *)vec_get(&v, 1) == 1);
+    assert(*(int *)vec_get(&v, 2) == 5);
+    assert(*(int *)vec_get(&v, 4) == 7);
+
+    /* Erase the tail, then an empty range, then everything. */
+    vec_erase_range(&v, 3, 2);
+    assert(vec_len(&v) == 3);
+    assert(*(int *)vec_tail(&v) == 5);
+
+    vec_erase_range(&v, 3, 0);
+    assert(vec_len(&v) == 3);
+
+    vec_erase_range(&v, 0, 3);
+    assert(vec_isempty(&v));
+
+    vec_destroy(&v);
+
+    return 0;
+}
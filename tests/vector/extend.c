@@ -0,0 +1,35 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int src[TEST_SIZE];
+    size_t i;
+
+    for (i = 0; i < TEST_SIZE; i++)
+        src[i] = (int)i;
+
+    vec_init(&v, sizeof(int), 0, realloc);
+
+    assert(vec_extend(&v, src, 0) == 0);
+    assert(vec_isempty(&v));
+
+    assert(vec_extend(&v, src, TEST_SIZE / 2) == 0);
+    assert(vec_extend(&v, src + TEST_SIZE / 2, TEST_SIZE - TEST_SIZE / 2) == 0);
+
+    assert(vec_len(&v) == TEST_SIZE);
+    assert(vec_space(&v) >= TEST_SIZE);
+    for (i = 0; i < TEST_SIZE; i++)
+        assert(*(int *)vec_get(&v, i) == (int)i);
+
+    vec_destroy(&v);
+
+    return 0;
+}
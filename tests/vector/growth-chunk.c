@@ -0,0 +1,35 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+#ifndef TEST_CHUNK
+#define TEST_CHUNK 10
+#endif
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    size_t prev;
+    int i;
+
+    vec_init(&v, sizeof(int), TEST_CHUNK, realloc);
+    vec_setgrowth(&v, vec_grow_chunk, TEST_CHUNK);
+
+    prev = vec_space(&v);
+    for (i = 0; i < 10 * TEST_CHUNK; i++)
+    {
+        vec_push(&v, &i);
+
+        /* The vector only ever grows by a single chunk at a time. */
+        assert(vec_space(&v) == prev || vec_space(&v) == prev + TEST_CHUNK);
+        prev = vec_space(&v);
+    }
+
+    for (i = 0; i < 10 * TEST_CHUNK; i++)
+        assert(*(int *)vec_get(&v, i) == i);
+
+    vec_destroy(&v);
+
+    return 0;
+}
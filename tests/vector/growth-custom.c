@@ -0,0 +1,46 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+static size_t calls;
+
+static size_t grow_exact(size_t space, size_t needed, size_t param)
+{
+    assert(param == 42);
+    assert(needed > space);
+
+    calls++;
+
+    return needed;
+}
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int src[8] = { 0 };
+    int i;
+
+    vec_init(&v, sizeof(int), 1, realloc);
+    vec_setgrowth(&v, grow_exact, 42);
+
+    for (i = 0; i < 4; i++)
+        vec_push(&v, &i);
+    assert(calls == 3);
+
+    /* A bulk insert only asks the growth rule once. */
+    vec_extend(&v, src, 8);
+    assert(calls == 4);
+    assert(vec_len(&v) == 12);
+
+    /* Nor do the one-half and doubling rules ever return too little. */
+    assert(vec_grow_onehalf(0, 1, 0) >= 1);
+    assert(vec_grow_onehalf(1, 2, 0) >= 2);
+    assert(vec_grow_onehalf(10, 100, 0) >= 100);
+    assert(vec_grow_double(0, 1, 0) >= 1);
+    assert(vec_grow_double(3, 100, 0) >= 100);
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int i = 42;
+
+    /* Growth rules must not wrap around when the needed space is huge. */
+    assert(vec_grow_double(SIZE_MAX / 2 + 2, SIZE_MAX, 0) == SIZE_MAX);
+    assert(vec_grow_double(3, SIZE_MAX - 1, 0) >= SIZE_MAX - 1);
+    assert(vec_grow_onehalf(SIZE_MAX / 2 + 2, SIZE_MAX, 0) == SIZE_MAX);
+    assert(vec_grow_onehalf(3, SIZE_MAX - 1, 0) >= SIZE_MAX - 1);
+    assert(vec_grow_chunk(3, SIZE_MAX - 1, 10) >= SIZE_MAX - 1);
+
+    vec_init(&v, sizeof(int), 4, realloc);
+    vec_push(&v, &i);
+
+    /* Asking for more elements than fit in a size_t worth of bytes fails and
+     * leaves the vector alone.
+     */
+    assert(vec_reserve(&v, SIZE_MAX / sizeof(int) + 1) == -1);
+    assert(vec_reserve(&v, SIZE_MAX) == -1);
+    assert(vec_extend(&v, &i, SIZE_MAX / sizeof(int)) == -1);
+    assert(vec_insert_range(&v, 0, &i, SIZE_MAX) == -1);
+    assert(vec_len(&v) == 1);
+    assert(vec_space(&v) == 4);
+    assert(*(int *)vec_get(&v, 0) == 42);
+
+    vec_destroy(&v);
+
+    return 0;
+}
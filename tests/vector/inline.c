@@ -0,0 +1,53 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+#ifndef TEST_INLINE
+#define TEST_INLINE 8
+#endif
+
+static size_t nalloc;
+
+static void *count_realloc(void *p, size_t size)
+{
+    if (size != 0)
+        nalloc++;
+
+    return realloc(p, size);
+}
+
+int main(int argc, char *argv[])
+{
+    struct { VEC_INLINE_DECL(int, TEST_INLINE); } small;
+    int i;
+
+    VEC_INLINE_INIT(&small, count_realloc);
+    assert(vec_space(&small.vec) == TEST_INLINE);
+
+    /* Filling the inline buffer never touches the allocator. */
+    for (i = 0; i < TEST_INLINE; i++)
+        vec_push(&small.vec, &i);
+    vec_shrink(&small.vec);
+    assert(nalloc == 0);
+    assert(small.vec.data == (char *)small.buf);
+
+    /* One more element spills everything onto the heap. */
+    vec_push(&small.vec, &i);
+    assert(nalloc == 1);
+    assert(small.vec.data != (char *)small.buf);
+    assert(vec_space(&small.vec) > TEST_INLINE);
+
+    for (i = 0; i <= TEST_INLINE; i++)
+        assert(*(int *)vec_get(&small.vec, i) == i);
+
+    vec_destroy(&small.vec);
+
+    /* A vector that never spills has nothing to free. */
+    VEC_INLINE_INIT(&small, count_realloc);
+    vec_push(&small.vec, &i);
+    vec_destroy(&small.vec);
+    assert(nalloc == 1);
+
+    return 0;
+}
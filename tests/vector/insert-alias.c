@@ -0,0 +1,60 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+/* Fill the vector with 0..n-1, in a buffer that is exactly full, so that the
+ * next insertion has to move it. */
+static void fill(struct vector *v, int n)
+{
+    int i;
+
+    vec_init(v, sizeof(int), n, realloc);
+    for (i = 0; i < n; i++)
+        vec_push(v, &i);
+    assert(vec_space(v) == vec_len(v));
+}
+
+static void check(const struct vector *v, const int *want, size_t n)
+{
+    size_t i;
+
+    assert(vec_len(v) == n);
+    for (i = 0; i < n; i++)
+        assert(*(int *)vec_get(v, i) == want[i]);
+}
+
+int main(int argc, char *argv[])
+{
+    static const int doubled[] = { 0, 1, 2, 3, 0, 1, 2, 3 };
+    static const int before[] = { 0, 1, 2, 3, 0, 1, 4, 5 };
+    static const int after[] = { 0, 4, 5, 1, 2, 3, 4, 5 };
+    static const int straddle[] = { 0, 1, 2, 1, 2, 3, 4, 5 };
+    struct vector v;
+
+    /* Append the vector to itself. */
+    fill(&v, 4);
+    assert(vec_extend(&v, vec_get(&v, 0), 4) == 0);
+    check(&v, doubled, 8);
+    vec_destroy(&v);
+
+    /* The source lies before the gap. */
+    fill(&v, 6);
+    assert(vec_insert_range(&v, 4, vec_get(&v, 0), 2) == 0);
+    check(&v, before, 8);
+    vec_destroy(&v);
+
+    /* The source lies after the gap, so it moves up with the tail. */
+    fill(&v, 6);
+    assert(vec_insert_range(&v, 1, vec_get(&v, 4), 2) == 0);
+    check(&v, after, 8);
+    vec_destroy(&v);
+
+    /* The gap opens in the middle of the source. */
+    fill(&v, 6);
+    assert(vec_insert_range(&v, 3, vec_get(&v, 1), 2) == 0);
+    check(&v, straddle, 8);
+    vec_destroy(&v);
+
+    return 0;
+}
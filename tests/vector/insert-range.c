@@ -0,0 +1,27 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int head[] = { 0, 1 };
+    int mid[] = { 2, 3, 4 };
+    int tail[] = { 5, 6 };
+    size_t i;
+
+    vec_init(&v, sizeof(int), 1, realloc);
+
+    vec_insert_range(&v, 0, tail, 2);
+    vec_insert_range(&v, 0, head, 2);
+    vec_insert_range(&v, 2, mid, 3);
+
+    assert(vec_len(&v) == 7);
+    for (i = 0; i < vec_len(&v); i++)
+        assert(*(int *)vec_get(&v, i) == (int)i);
+
+    vec_destroy(&v);
+
+    return 0;
+}
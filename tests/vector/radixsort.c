@@ -0,0 +1,70 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 10000
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED 1234
+#endif
+
+struct rec
+{
+    char tag;
+    uint32_t key;
+    size_t order;
+};
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    struct rec r, *prev, *cur;
+    uint64_t k;
+    size_t i;
+
+    vec_init(&v, sizeof(struct rec), 0, realloc);
+    srand(TEST_SEED);
+
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        r.tag = 'x';
+        r.key = (uint32_t)rand() % 5000 * 70001u;
+        r.order = i;
+        vec_push(&v, &r);
+    }
+
+    assert(vec_radixsort(&v, offsetof(struct rec, key), sizeof(uint32_t))
+            == 0);
+
+    /* Sorted by key, and stable for equal keys. */
+    for (i = 1; i < TEST_SIZE; i++)
+    {
+        prev = vec_get(&v, i - 1);
+        cur = vec_get(&v, i);
+        assert(prev->key <= cur->key);
+        assert(prev->key != cur->key || prev->order < cur->order);
+        assert(cur->tag == 'x');
+    }
+
+    vec_destroy(&v);
+
+    /* 64-bit keys that only differ in their high byte. */
+    vec_init(&v, sizeof(uint64_t), 0, realloc);
+    for (i = 0; i < 256; i++)
+    {
+        k = (uint64_t)(255 - i) << 56;
+        vec_push(&v, &k);
+    }
+    assert(vec_radixsort(&v, 0, sizeof(uint64_t)) == 0);
+    for (i = 0; i < 256; i++)
+        assert(*(uint64_t *)vec_get(&v, i) == (uint64_t)i << 56);
+
+    vec_destroy(&v);
+
+    return 0;
+}
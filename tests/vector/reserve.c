@@ -0,0 +1,34 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1000
+#endif
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    size_t space;
+    int i;
+
+    vec_init(&v, sizeof(int), 0, realloc);
+
+    assert(vec_reserve(&v, TEST_SIZE) == 0);
+    space = vec_space(&v);
+    assert(space >= TEST_SIZE);
+
+    /* Pushing up to the reserved length must never reallocate. */
+    for (i = 0; i < TEST_SIZE; i++)
+        vec_push(&v, &i);
+    assert(vec_space(&v) == space);
+
+    /* Reserving less than is already available does nothing. */
+    assert(vec_reserve(&v, 1) == 0);
+    assert(vec_space(&v) == space);
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    int i;
+
+    vec_init(&v, sizeof(int), 4, realloc);
+
+    /* A vector can be filled all the way to its space. */
+    for (i = 0; i < 4; i++)
+        vec_push(&v, &i);
+    assert(vec_space(&v) == 4);
+
+    vec_push(&v, &i);
+    vec_shrink(&v);
+    assert(vec_space(&v) == vec_len(&v));
+
+    vec_swap(&v, 0, 4);
+    assert(*(int *)vec_get(&v, 0) == 4);
+    assert(*(int *)vec_get(&v, 4) == 0);
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 10000
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED 1234
+#endif
+
+static int cmp(const void *a, const void *b)
+{
+    const int *_a = a, *_b = b;
+
+    return (*_a > *_b) - (*_a < *_b);
+}
+
+static void check_sorted(const struct vector *v, long sum)
+{
+    size_t i;
+
+    for (i = 0; i < vec_len(v); i++)
+    {
+        sum -= *(int *)vec_get(v, i);
+        if (i > 0)
+            assert(*(int *)vec_get(v, i - 1) <= *(int *)vec_get(v, i));
+    }
+
+    /* Nothing was lost or duplicated along the way. */
+    assert(sum == 0);
+}
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    size_t n, i;
+    long sum;
+    int e;
+
+    vec_init(&v, sizeof(int), 0, realloc);
+    srand(TEST_SEED);
+
+    /* Random keys, lots of duplicates, already sorted, and reversed, at sizes
+     * around the insertion sort cutoff as well as large ones.
+     */
+    for (n = 0; n <= TEST_SIZE; n = (n < 2 * VEC_SORT_CUTOFF) ? n + 1 : n * 3)
+    {
+        vec_erase_range(&v, 0, vec_len(&v));
+        for (sum = 0, i = 0; i < n; i++)
+        {
+            e = rand() % 1000 - 500;
+            sum += e;
+            vec_push(&v, &e);
+        }
+        vec_sort(&v, cmp);
+        check_sorted(&v, sum);
+
+        for (sum = 0, i = 0; i < n; i++)
+        {
+            e = rand() % 3;
+            sum += e;
+            vec_set(&v, i, &e);
+        }
+        vec_sort(&v, cmp);
+        check_sorted(&v, sum);
+
+        for (sum = 0, i = 0; i < n; i++)
+        {
+            e = (int)(n - i);
+            sum += e;
+            vec_set(&v, i, &e);
+        }
+        vec_sort(&v, cmp);
+        check_sorted(&v, sum);
+        vec_sort(&v, cmp);
+        check_sorted(&v, sum);
+    }
+
+    vec_destroy(&v);
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+/* Larger than VEC_SWAP_CHUNK, and not a multiple of it. */
+struct big
+{
+    unsigned char bytes[3 * VEC_SWAP_CHUNK + 7];
+};
+
+int main(int argc, char *argv[])
+{
+    struct vector v;
+    struct big b;
+    struct big *p;
+    size_t i;
+
+    vec_init(&v, sizeof(struct big), 2, realloc);
+
+    for (i = 0; i < sizeof(b.bytes); i++)
+        b.bytes[i] = (unsigned char)i;
+    vec_push(&v, &b);
+    for (i = 0; i < sizeof(b.bytes); i++)
+        b.bytes[i] = (unsigned char)~i;
+    vec_push(&v, &b);
+
+    vec_swap(&v, 0, 1);
+
+    p = vec_get(&v, 0);
+    for (i = 0; i < sizeof(b.bytes); i++)
+        assert(p->bytes[i] == (unsigned char)~i);
+    p = vec_get(&v, 1);
+    for (i = 0; i < sizeof(b.bytes); i++)
+        assert(p->bytes[i] == (unsigned char)i);
+
+    vec_destroy(&v);
+
+    return 0;
+}
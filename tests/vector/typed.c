@@ -0,0 +1,57 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE 1024
+#endif
+
+struct point
+{
+    short x;
+    double y;
+};
+
+VECTOR_DEFINE(intvec, int)
+VECTOR_DEFINE(ptvec, struct point)
+
+int main(int argc, char *argv[])
+{
+    struct vector v, w;
+    struct point pt;
+    int i;
+
+    intvec_init(&v, 0, realloc);
+    for (i = 0; i < TEST_SIZE; i++)
+        assert(intvec_push(&v, i) == i);
+
+    assert(intvec_len(&v) == TEST_SIZE);
+    assert(vec_len(&v) == TEST_SIZE);
+
+    /* The typed and generic accessors see the same elements. */
+    for (i = 0; i < TEST_SIZE; i++)
+    {
+        assert(intvec_get(&v, i) == i);
+        assert(*(int *)vec_get(&v, i) == i);
+        intvec_set(&v, i, 2 * i);
+    }
+    for (i = TEST_SIZE - 1; i >= 0; i--)
+        assert(intvec_pop(&v) == 2 * i);
+    assert(vec_isempty(&v));
+
+    ptvec_init(&w, 1, realloc);
+    pt.x = 1;
+    pt.y = 2.5;
+    ptvec_push(&w, pt);
+    pt.x = 3;
+    ptvec_push(&w, pt);
+    assert(ptvec_at(&w, 0)->x == 1);
+    assert(ptvec_get(&w, 0).y == 2.5);
+    assert(ptvec_pop(&w).x == 3);
+
+    vec_destroy(&v);
+    vec_destroy(&w);
+
+    return 0;
+}
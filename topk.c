@@ -0,0 +1,271 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file topk.c
+ *
+ * \brief Bounded selection of the K largest elements of a stream.
+ *
+ * Until the selector is full, offered elements are just pushed onto the heap.
+ * After that, an element is only added if it is bigger than the root, in which
+ * case it replaces the root with a single sift.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "binheap.h"
+#include "topk.h"
+
+/**
+ * \brief Initialize a top-K selector so that it is ready to be used.
+ *
+ * Space for all \p k elements is allocated up front, so offering elements
+ * never needs any more memory.
+ *
+ * \param [out] tk Pointer to the selector to initialize.
+ * \param [in] cmp Function for comparing two elements; the largest elements
+ *                 according to this function are kept.
+ * \param [in] elemsize Size of each element.
+ * \param [in] k Maximum number of elements to keep.
+ * \param [in] alloc Memory allocator used for all allocation for the
+ *                   selector. Interface should be equivalent to \c realloc.
+ *
+ * \return Returns \c 0 on success, or \c -1 if memory could not be allocated.
+ *
+ * \pre <tt>tk != NULL</tt>
+ * \pre <tt>cmp != NULL</tt>
+ */
+int topk_init(struct topk *tk, cmp_func cmp, size_t elemsize, size_t k,
+        void *(*alloc)(void *, size_t))
+{
+    assert(tk != NULL);
+    assert(cmp != NULL);
+
+    tk->k = k;
+
+    /* The vector needs at least one element of space. */
+    return binheap_init(&tk->heap, cmp, elemsize, k > 0 ? k : 1, alloc);
+}
+
+/**
+ * \brief Free all the memory associated with the selector.
+ *
+ * \param [in,out] tk Pointer to the selector to destroy.
+ *
+ * \pre <tt>tk != NULL</tt>
+ */
+void topk_destroy(struct topk *tk)
+{
+    assert(tk != NULL);
+
+    binheap_destroy(&tk->heap);
+}
+
+/**
+ * \brief Offer an element to the selector.
+ *
+ * If the selector is full and \p e is no bigger than the smallest element
+ * kept, it is rejected after one comparison. Otherwise, a copy of \p e is
+ * kept, and the smallest element is dropped if needed to make room for it.
+ *
+ * \param [in,out] tk Pointer to the selector.
+ * \param [in] e Element to offer.
+ *
+ * \return Returns \c 1 if the element was kept, \c 0 if it was rejected, or
+ * \c -1 if memory could not be allocated for it.
+ *
+ * \pre <tt>tk != NULL</tt>
+ * \pre <tt>e != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(log k), and
+ * takes O(1) time for rejected elements.
+ */
+int topk_offer(struct topk *tk, const void *e)
+{
+    assert(tk != NULL);
+    assert(e != NULL);
+
+    if (!topk_isfull(tk))
+        return binheap_push(&tk->heap, e) == -1 ? -1 : 1;
+
+    if (tk->k == 0 || tk->heap.cmp(e, binheap_peek(&tk->heap)) <= 0)
+        return 0;
+
+    binheap_replace(&tk->heap, e, NULL);
+
+    return 1;
+}
+
+/**
+ * \brief Offer each element of an array to the selector.
+ *
+ * This gives the same result as calling #topk_offer() on each element in
+ * turn. Once the selector is full, the array is scanned with a tight loop
+ * that only compares each element against the smallest element kept, and the
+ * heap is only touched for the elements that pass.
+ *
+ * \param [in,out] tk Pointer to the selector.
+ * \param [in] buf Array of elements to offer.
+ * \param [in] n Number of elements in \p buf.
+ *
+ * \return Returns the number of elements that were kept. This may include
+ * elements that were later pushed out by bigger elements of the same array.
+ *
+ * \pre <tt>tk != NULL</tt>
+ * \pre <tt>buf != NULL || n == 0</tt>
+ */
+size_t topk_offer_n(struct topk *tk, const void *buf, size_t n)
+{
+    const char *e;
+    const char *end;
+    const void *min;
+    size_t elemsize;
+    size_t kept = 0;
+    cmp_func cmp;
+
+    assert(tk != NULL);
+    assert(buf != NULL || n == 0);
+
+    if (tk->k == 0)
+        return 0;
+
+    elemsize = tk->heap.vec.elemsize;
+    e = buf;
+    end = e + n * elemsize;
+
+    /* Fill up the heap first. */
+    for (; e < end && !topk_isfull(tk); e += elemsize)
+    {
+        if (topk_offer(tk, e) == 1)
+            kept++;
+    }
+
+    /* The root always stays at the same address, so there is no need to peek
+     * again after each replacement. */
+    min = binheap_peek(&tk->heap);
+    cmp = tk->heap.cmp;
+
+    for (; e < end; e += elemsize)
+    {
+        if (cmp(e, min) > 0)
+        {
+            binheap_replace(&tk->heap, e, NULL);
+            kept++;
+        }
+    }
+
+    return kept;
+}
+
+/**
+ * \brief Get the smallest element kept by the selector.
+ *
+ * Once the selector is full, this is the K-th largest element seen so far, and
+ * anything no bigger than it will be rejected.
+ *
+ * \param [in] tk Pointer to the selector.
+ *
+ * \return Returns a pointer to the smallest element kept, or \c NULL if no
+ * elements are kept.
+ *
+ * \pre <tt>tk != NULL</tt>
+ */
+void *topk_peek(const struct topk *tk)
+{
+    assert(tk != NULL);
+
+    return binheap_peek(&tk->heap);
+}
+
+/**
+ * \brief Get the number of elements kept by the selector.
+ *
+ * \param [in] tk Pointer to the selector.
+ *
+ * \return Returns the number of elements kept, which is never more than \c k.
+ *
+ * \pre <tt>tk != NULL</tt>
+ */
+size_t topk_len(const struct topk *tk)
+{
+    assert(tk != NULL);
+
+    return binheap_len(&tk->heap);
+}
+
+/**
+ * \brief Determine if the selector holds \c k elements.
+ *
+ * \param [in] tk Pointer to the selector.
+ *
+ * \return Returns nonzero if the selector is full, or zero otherwise.
+ *
+ * \pre <tt>tk != NULL</tt>
+ */
+int topk_isfull(const struct topk *tk)
+{
+    return topk_len(tk) >= tk->k;
+}
+
+/**
+ * \brief Copy out all the elements kept, largest first, and empty the
+ * selector.
+ *
+ * The selector can be used again afterwards, starting from scratch.
+ *
+ * \param [in,out] tk Pointer to the selector.
+ * \param [out] buf Array with room for #topk_len() elements.
+ *
+ * \return Returns the number of elements copied to \p buf.
+ *
+ * \pre <tt>tk != NULL</tt>
+ * \pre <tt>buf != NULL</tt>
+ *
+ * \note This operation has a worst-case time complexity of O(k log k).
+ */
+size_t topk_drain(struct topk *tk, void *buf)
+{
+    char *dst;
+    size_t n;
+    size_t i;
+
+    assert(tk != NULL);
+    assert(buf != NULL);
+
+    n = topk_len(tk);
+
+    /* Popping gives the smallest first, so fill the array from the back. */
+    for (i = n; i > 0; i--)
+    {
+        dst = (char *)buf + (i - 1) * tk->heap.vec.elemsize;
+        binheap_pop_into(&tk->heap, dst);
+    }
+
+    return n;
+}
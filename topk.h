@@ -0,0 +1,76 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file topk.h
+ *
+ * \brief Bounded selection of the K largest elements of a stream.
+ *
+ * A top-K selector keeps the \c k largest elements offered to it, according to
+ * a comparison function, using a binary min-heap of at most \c k elements. The
+ * root of the heap is the smallest element kept, so any new element that is
+ * no bigger than it can be rejected after a single comparison, without
+ * touching the rest of the heap. Once the selector is full, most elements of a
+ * long stream are rejected this way, and the heap never grows past \c k.
+ *
+ * To keep the \c k smallest elements instead, negate the comparison function.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _TOPK_H_
+#define _TOPK_H_
+
+
+#include <stddef.h>
+
+#include "binheap.h"
+#include "utils.h"
+
+/**
+ * \brief Selector for the K largest elements of a stream.
+ *
+ * Must be initialized with #topk_init() before it can be used, and destroyed
+ * with #topk_destroy() when it is no longer needed.
+ */
+struct topk
+{
+    struct binheap heap; /**< Min-heap of the elements kept so far. */
+    size_t k;            /**< Maximum number of elements to keep. */
+};
+
+int topk_init(struct topk *tk, cmp_func cmp, size_t elemsize, size_t k,
+        void *(*alloc)(void *, size_t));
+void topk_destroy(struct topk *tk);
+int topk_offer(struct topk *tk, const void *e);
+size_t topk_offer_n(struct topk *tk, const void *buf, size_t n);
+void *topk_peek(const struct topk *tk);
+size_t topk_len(const struct topk *tk);
+int topk_isfull(const struct topk *tk);
+size_t topk_drain(struct topk *tk, void *buf);
+
+
+#endif /* end of include guard: _TOPK_H_ */
@@ -0,0 +1,232 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+/**
+ * \file vecaligned.c
+ *
+ * \brief Vectors with aligned buffers.
+ *
+ * Small buffers come from \c posix_memalign(). With the #VEC_HUGEPAGE flag,
+ * large buffers are mapped directly instead, so that they can be backed by huge
+ * pages and grown with \c mremap().
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+/* Needed for mremap() and MADV_HUGEPAGE. */
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "vecaligned.h"
+#include "vector.h"
+
+/* Reallocate the buffer of an aligned vector. */
+static void *_vec_realloc_aligned(const struct vector *v, size_t size);
+
+/* Initialize a vector whose buffer is aligned to 'align' bytes. */
+int vec_init_aligned(struct vector *v, size_t elemsize, size_t len,
+        size_t align, unsigned flags)
+{
+    assert(v != NULL);
+    assert(elemsize != 0);
+    assert(align != 0 && (align & (align - 1)) == 0);
+
+    v->len = 0;
+    v->elemsize = elemsize;
+    v->data = NULL;
+    v->space = 0;
+    v->grow = vec_grow_double;
+    v->growparam = 0;
+
+    /* The buffer is managed by _vec_realloc_aligned() instead. */
+    v->realloc = NULL;
+    v->resize = _vec_realloc_aligned;
+
+    /* posix_memalign() requires at least pointer alignment. */
+    v->align = (align < sizeof(void *)) ? sizeof(void *) : align;
+    v->flags = flags;
+    v->fd = -1;
+
+    if (len == 0)
+        len = DEF_VEC_LEN;
+
+    return vec_resize(v, len * elemsize);
+}
+
+/* Round 'size' up to a whole number of pages. */
+static size_t _vec_pagelen(size_t size)
+{
+    size_t page;
+
+    page = (size_t)sysconf(_SC_PAGESIZE);
+
+    return ((size + page - 1) / page) * page;
+}
+
+/* Check if a buffer of 'size' bytes for the vector should be backed by huge
+ * pages. Since this only depends on the size, it also tells us how the current
+ * buffer was allocated.
+ */
+static int _vec_ishuge(const struct vector *v, size_t size)
+{
+    return (v->flags & VEC_HUGEPAGE) && size >= VEC_HUGEPAGE_MIN;
+}
+
+/* Get the alignment of a huge page buffer for the vector: a huge page
+ * boundary, or the vector's own alignment if that is stricter. Both are powers
+ * of two, so this is a multiple of each.
+ */
+static size_t _vec_hugealign(const struct vector *v)
+{
+    return (v->align > VEC_HUGEPAGE_MIN) ? v->align : VEC_HUGEPAGE_MIN;
+}
+
+/* Map 'size' bytes of anonymous memory, aligned to 'align' bytes (a multiple of
+ * the huge page size) so that the kernel can back all of it with huge pages.
+ * Returns NULL on failure.
+ */
+static void *_vec_maphuge(size_t size, size_t align)
+{
+    char *raw;
+    char *start;
+    size_t len;
+
+    len = _vec_pagelen(size);
+
+    /* Map an extra 'align' bytes, then trim off the unaligned head and
+     * tail. */
+    raw = mmap(NULL, len + align, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+        return NULL;
+
+    start = raw + (align - (uintptr_t)raw % align) % align;
+    if (start != raw)
+        munmap(raw, start - raw);
+    if (start + len != raw + len + align)
+        munmap(start + len, (raw + len + align) - (start + len));
+
+#ifdef MADV_HUGEPAGE
+    /* This is only a hint, so there is nothing to do if it fails. */
+    madvise(start, len, MADV_HUGEPAGE);
+#endif
+
+    return start;
+}
+
+/* Reallocate the buffer of an aligned vector to 'size' bytes. The old buffer
+ * is 'v->space' elements long (or doesn't exist if 'v->data' is NULL). Small
+ * buffers come from posix_memalign(); if the vector was created with the
+ * VEC_HUGEPAGE flag, large buffers are mapped directly and marked for huge
+ * pages. Returns the new buffer, or NULL (leaving the old buffer untouched) on
+ * failure. If 'size' is 0, the old buffer is freed and NULL is returned.
+ */
+static void *_vec_realloc_aligned(const struct vector *v, size_t size)
+{
+    void *blk;
+    size_t oldsize;
+
+    assert(v != NULL);
+    assert(v->align != 0);
+
+    oldsize = (v->data != NULL) ? v->space * v->elemsize : 0;
+
+    if (size == 0)
+    {
+        blk = NULL;
+    }
+    else if (_vec_ishuge(v, size) && _vec_ishuge(v, oldsize))
+    {
+        /* Both buffers are mappings, so let the kernel move the pages rather
+         * than copying them. First try to resize in place, which keeps the
+         * alignment.
+         */
+#ifdef MREMAP_MAYMOVE
+        blk = mremap(v->data, _vec_pagelen(oldsize), _vec_pagelen(size), 0);
+        if (blk == MAP_FAILED)
+        {
+            /* Letting the kernel pick a new address would only keep page
+             * alignment, so map an aligned buffer first and move the pages
+             * there. If the move fails, fall back to copying below; either
+             * way, the old buffer is untouched if anything fails.
+             */
+            blk = _vec_maphuge(size, _vec_hugealign(v));
+            if (blk == NULL)
+                return NULL;
+#ifdef MREMAP_FIXED
+            if (mremap(v->data, _vec_pagelen(oldsize), _vec_pagelen(size),
+                        MREMAP_MAYMOVE | MREMAP_FIXED, blk) != MAP_FAILED)
+            {
+#ifdef MADV_HUGEPAGE
+                madvise(blk, _vec_pagelen(size), MADV_HUGEPAGE);
+#endif
+                return blk;
+            }
+#endif
+        }
+        else
+        {
+#ifdef MADV_HUGEPAGE
+            madvise(blk, _vec_pagelen(size), MADV_HUGEPAGE);
+#endif
+            assert((uintptr_t)blk % _vec_hugealign(v) == 0);
+            return blk;
+        }
+#else
+        blk = _vec_maphuge(size, _vec_hugealign(v));
+#endif
+    }
+    else if (_vec_ishuge(v, size))
+    {
+        blk = _vec_maphuge(size, _vec_hugealign(v));
+    }
+    else if (posix_memalign(&blk, v->align, size) != 0)
+    {
+        blk = NULL;
+    }
+
+    if (blk == NULL && size != 0)
+        return NULL;
+
+    /* Move the contents over to the new buffer, then free the old one. */
+    if (v->data != NULL)
+    {
+        if (blk != NULL)
+            memcpy(blk, v->data, (oldsize < size) ? oldsize : size);
+
+        if (_vec_ishuge(v, oldsize))
+            munmap(v->data, _vec_pagelen(oldsize));
+        else
+            free(v->data);
+    }
+
+    return blk;
+}
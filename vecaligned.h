@@ -0,0 +1,58 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file vecaligned.h
+ *
+ * \brief Vectors with aligned buffers.
+ *
+ * An aligned vector is an ordinary \c struct \c vector whose buffer is always
+ * aligned to a given power of two, so that SIMD code can use aligned loads and
+ * stores on it. A \c realloc() style allocator has no way to ask for an
+ * alignment, so the buffer is managed here instead, with \c posix_memalign();
+ * large buffers may also be mapped directly and backed by huge pages. Once
+ * initialized, the vector works with all of the usual \c vec_* functions.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _VECALIGNED_H_
+#define _VECALIGNED_H_
+
+
+#include <stddef.h>
+
+#include "vector.h"
+
+/* Smallest buffer (in bytes) that is backed by huge pages. */
+#define VEC_HUGEPAGE_MIN    ((size_t)2 * 1024 * 1024)
+
+/* Initialize a vector with an aligned buffer. */
+int vec_init_aligned(struct vector *v, size_t elemsize, size_t len,
+        size_t align, unsigned flags);
+
+
+#endif /* end of include guard: _VECALIGNED_H_ */
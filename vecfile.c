@@ -0,0 +1,253 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+/**
+ * \file vecfile.c
+ *
+ * \brief Vectors stored in memory-mapped files.
+ *
+ * The file starts with a #VEC_FILE_HEADER byte header, followed by the
+ * elements. The whole file is mapped with \c MAP_SHARED, and resized with \c
+ * ftruncate() and \c mremap() as the vector grows and shrinks.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+/* Needed for mremap(). */
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vecfile.h"
+#include "vector.h"
+
+/* Map the file of a file-backed vector. */
+static int _vec_mapfile(struct vector *v, size_t elemsize);
+/* Remap the file backing a file-backed vector. */
+static void *_vec_remap(const struct vector *v, size_t size);
+
+/*
+ * Header at the start of the file backing a file-backed vector. The elements
+ * start VEC_FILE_HEADER bytes into the file.
+ */
+struct _vec_fileheader
+{
+    char magic[8];      /* Always VEC_FILE_MAGIC. */
+    uint64_t elemsize;  /* Size of each element. */
+    uint64_t len;       /* Number of elements, as of the last sync. */
+};
+
+/* Magic number identifying a file-backed vector. */
+static const char VEC_FILE_MAGIC[8] = "FDRYVEC1";
+
+/* Open (or create) a vector stored in the file at 'path'. */
+int vec_open(struct vector *v, size_t elemsize, const char *path)
+{
+    int rc;
+
+    assert(v != NULL);
+    assert(elemsize != 0);
+    assert(path != NULL);
+
+    v->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (v->fd == -1)
+        return -1;
+
+    /* If the file can't be mapped, don't leak the descriptor. */
+    rc = _vec_mapfile(v, elemsize);
+    if (rc != 0)
+    {
+        close(v->fd);
+        v->fd = -1;
+    }
+
+    return rc;
+}
+
+/* Write the length of a file-backed vector to its file and flush it. */
+int vec_sync(struct vector *v)
+{
+    struct _vec_fileheader *hdr;
+
+    assert(v != NULL);
+    assert(v->flags & VEC_FILE);
+
+    hdr = (struct _vec_fileheader *)(v->data - VEC_FILE_HEADER);
+    hdr->len = vec_len(v);
+
+    return msync(hdr, VEC_FILE_HEADER + vec_space(v) * v->elemsize, MS_SYNC);
+}
+
+/* Map the file opened in 'v->fd' as the buffer of the vector. If the file is
+ * empty, it is initialized with a header and room for the default number of
+ * elements. Otherwise, the header must match 'elemsize'. Returns 0 on success,
+ * or -1 on failure.
+ */
+static int _vec_mapfile(struct vector *v, size_t elemsize)
+{
+    struct _vec_fileheader hdr;
+    struct stat st;
+    char *base;
+
+    assert(v != NULL);
+    assert(sizeof(hdr) <= VEC_FILE_HEADER);
+
+    if (fstat(v->fd, &st) == -1)
+        return -1;
+
+    /* A new (empty) file gets a fresh header and the default space. */
+    if (st.st_size == 0)
+    {
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, VEC_FILE_MAGIC, sizeof(hdr.magic));
+        hdr.elemsize = elemsize;
+        hdr.len = 0;
+
+        st.st_size = VEC_FILE_HEADER + DEF_VEC_LEN * elemsize;
+        if (ftruncate(v->fd, st.st_size) == -1
+                || pwrite(v->fd, &hdr, sizeof(hdr), 0) != sizeof(hdr))
+            return -1;
+    }
+    /* Otherwise, make sure the file holds a vector of the same type. */
+    else if ((size_t)st.st_size < VEC_FILE_HEADER
+            || pread(v->fd, &hdr, sizeof(hdr), 0) != sizeof(hdr)
+            || memcmp(hdr.magic, VEC_FILE_MAGIC, sizeof(hdr.magic)) != 0
+            || hdr.elemsize != elemsize
+            || hdr.len > (st.st_size - VEC_FILE_HEADER) / elemsize)
+    {
+        return -1;
+    }
+
+    /* Map the whole file. No elements are read; the vector is usable as soon
+     * as the mapping exists.
+     */
+    base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, v->fd,
+            0);
+    if (base == MAP_FAILED)
+        return -1;
+
+    v->data = base + VEC_FILE_HEADER;
+    v->realloc = NULL;
+    v->resize = _vec_remap;
+    v->len = hdr.len;
+    v->elemsize = elemsize;
+    v->space = (st.st_size - VEC_FILE_HEADER) / elemsize;
+    v->grow = vec_grow_double;
+    v->growparam = 0;
+    v->align = 0;
+    v->flags = VEC_FILE;
+
+    return 0;
+}
+
+/* Set the length of the file 'fd' to 'len' bytes without changing 'errno', for
+ * use after something else has already failed. Returns 0 on success, or -1 on
+ * failure.
+ */
+static int _vec_truncate(int fd, size_t len)
+{
+    int err;
+    int rc;
+
+    err = errno;
+    rc = ftruncate(fd, len);
+    errno = err;
+
+    return rc;
+}
+
+/* Resize the file backing a file-backed vector so that it holds 'size' bytes of
+ * elements, and remap it. Returns a pointer to the elements in the new mapping,
+ * or NULL (leaving the mapping unchanged, and 'errno' set) on failure. The file
+ * is never shorter than the mapping, but may be left longer if it can't be
+ * shrunk; the header only counts the elements in use, so the next vec_open()
+ * just maps the extra space as spare capacity. If 'size' is 0, the length is
+ * written to the header, the file is unmapped and closed, and NULL is returned.
+ */
+static void *_vec_remap(const struct vector *v, size_t size)
+{
+    char *base;
+    size_t oldlen, newlen;
+
+    assert(v != NULL);
+    assert(v->flags & VEC_FILE);
+
+    base = v->data - VEC_FILE_HEADER;
+    oldlen = VEC_FILE_HEADER + vec_space(v) * v->elemsize;
+    newlen = VEC_FILE_HEADER + size;
+
+    /* The vector is being destroyed. The file is just unmapped, so it keeps
+     * its contents and can be opened again.
+     */
+    if (size == 0)
+    {
+        ((struct _vec_fileheader *)base)->len = vec_len(v);
+        munmap(base, oldlen);
+        close(v->fd);
+        return NULL;
+    }
+
+    /* The file has to be big enough before the mapping can cover it. */
+    if (newlen > oldlen && ftruncate(v->fd, newlen) == -1)
+        return NULL;
+
+#ifdef MREMAP_MAYMOVE
+    base = mremap(base, oldlen, newlen, MREMAP_MAYMOVE);
+#else
+    /* Since the mapping is shared, the contents are all in the file; just map
+     * it again at the new size.
+     */
+    base = mmap(NULL, newlen, PROT_READ | PROT_WRITE, MAP_SHARED, v->fd, 0);
+    if (base != MAP_FAILED)
+        munmap(v->data - VEC_FILE_HEADER, oldlen);
+#endif
+
+    /* Give back the space added to the file above. If that fails too, the file
+     * is just left longer than the mapping, which is harmless; either way,
+     * 'errno' still says why the mapping failed.
+     */
+    if (base == MAP_FAILED)
+    {
+        if (newlen > oldlen)
+            (void)_vec_truncate(v->fd, oldlen);
+        return NULL;
+    }
+
+    /* Only give the space back once nothing maps it any more. The mapping has
+     * already shrunk, so a failure here can't be undone; the file is just left
+     * longer than the mapping, and the resize still succeeds.
+     */
+    if (newlen < oldlen)
+        (void)_vec_truncate(v->fd, newlen);
+
+    return base + VEC_FILE_HEADER;
+}
@@ -0,0 +1,57 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file vecfile.h
+ *
+ * \brief Vectors stored in memory-mapped files.
+ *
+ * A file-backed vector is an ordinary \c struct \c vector whose buffer is a
+ * shared mapping of a file, so the elements persist across runs and can be
+ * shared with other processes. Once opened, the vector works with all of the
+ * usual \c vec_* functions; growing or shrinking it resizes the file as well.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _VECFILE_H_
+#define _VECFILE_H_
+
+
+#include <stddef.h>
+
+#include "vector.h"
+
+/* Size of the header at the start of the file of a file-backed vector. */
+#define VEC_FILE_HEADER     64
+
+/* Open a vector stored in a file, creating the file if needed. */
+int vec_open(struct vector *v, size_t elemsize, const char *path);
+/* Write the length of a file-backed vector back to its file. */
+int vec_sync(struct vector *v);
+
+
+#endif /* end of include guard: _VECFILE_H_ */
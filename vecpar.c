@@ -0,0 +1,379 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file vecpar.c
+ *
+ * \brief Parallel operations over vectors.
+ *
+ * Each operation splits the vector into one chunk per thread, runs the
+ * per-element function over each chunk in parallel, then joins the threads. No
+ * threads are kept alive between calls.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vecpar.h"
+#include "vector.h"
+
+/**
+ * \brief Work given to a single thread.
+ */
+struct vecpar_task
+{
+    const struct vector *v; /**< Vector being operated on. */
+    size_t start;           /**< Index of the first element in the chunk. */
+    size_t end;             /**< Index one past the last element. */
+    vec_operator map;       /**< Operator for #vec_pmap(), or \c NULL. */
+    vec_reducer reduce;     /**< Reducer for #vec_preduce(), or \c NULL. */
+    void *acc;              /**< Accumulator for this chunk. */
+    void *scratch;          /**< Scratch argument passed to the operator. */
+    pthread_t thread;       /**< Thread processing the chunk. */
+    int started;            /**< Nonzero if \c thread was started. */
+};
+
+/**
+ * \brief Get the number of elements that span a whole number of cache lines.
+ *
+ * Chunks are always a multiple of this many elements long, so that every chunk
+ * boundary lands on a cache line boundary.
+ *
+ * \param [in] elemsize Size of each element of the vector.
+ *
+ * \return Returns the smallest number of elements \c n such that <tt>n *
+ * elemsize</tt> is a multiple of #VECPAR_CACHE_LINE.
+ */
+static size_t _granularity(size_t elemsize)
+{
+    size_t a, b, t;
+
+    /* Find gcd(elemsize, VECPAR_CACHE_LINE) with Euclid's algorithm. */
+    a = elemsize;
+    b = VECPAR_CACHE_LINE;
+    while (b != 0)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return VECPAR_CACHE_LINE / a;
+}
+
+/**
+ * \brief Get the index of the first element that starts on a cache line.
+ *
+ * The buffer of a vector is not necessarily aligned to a cache line, so the
+ * chunk boundaries are counted from the first element that is. Which elements
+ * start on a cache line repeats every #_granularity() elements, so only that
+ * many need to be checked.
+ *
+ * \param [in] v Vector to check.
+ *
+ * \return Returns the index of the first element whose address is a multiple
+ * of #VECPAR_CACHE_LINE. Returns \c 0 if no element is aligned, which can only
+ * happen if the buffer is less aligned than the elements themselves.
+ */
+static size_t _first_aligned(const struct vector *v)
+{
+    uintptr_t addr = (uintptr_t)v->data;
+    size_t gran, i;
+
+    gran = _granularity(v->elemsize);
+    for (i = 0; i < gran; i++)
+    {
+        if ((addr + i * v->elemsize) % VECPAR_CACHE_LINE == 0)
+            return i;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Split the vector into chunks, one for each task.
+ *
+ * Each chunk gets roughly the same number of elements, rounded to a whole
+ * number of cache lines. The boundaries are placed on cache lines of the
+ * buffer itself, so the first chunk also takes the elements before the first
+ * aligned one. The last chunk takes whatever is left over, and may be empty if
+ * the vector is small.
+ *
+ * \param [in] v Vector to split up.
+ * \param [out] tasks Array of tasks in which to store the chunk bounds.
+ * \param [in] ntasks Number of tasks in \p tasks.
+ */
+static void _split(const struct vector *v, struct vecpar_task *tasks,
+        unsigned ntasks)
+{
+    size_t gran, per, first, start, end;
+    unsigned i;
+
+    gran = _granularity(v->elemsize);
+    first = _first_aligned(v);
+
+    /* Round the chunk length up so that every element ends up in a chunk. */
+    per = (vec_len(v) + ntasks - 1) / ntasks;
+    per = ((per + gran - 1) / gran) * gran;
+
+    start = 0;
+    for (i = 0; i < ntasks; i++)
+    {
+        end = first + (i + 1) * per;
+        if (end > vec_len(v) || i == ntasks - 1)
+            end = vec_len(v);
+
+        tasks[i].v = v;
+        tasks[i].start = start;
+        tasks[i].end = end;
+        tasks[i].started = 0;
+        start = end;
+    }
+
+    assert(start == vec_len(v));
+}
+
+/**
+ * \brief Run a task over its chunk of the vector.
+ *
+ * This is the entry point of each thread, but is also called directly for the
+ * chunks processed by the calling thread.
+ *
+ * \param [in] arg Pointer to the #vecpar_task to run.
+ *
+ * \return Always returns \c NULL.
+ */
+static void *_run(void *arg)
+{
+    struct vecpar_task *task = arg;
+    size_t i;
+
+    if (task->map != NULL)
+    {
+        for (i = task->start; i < task->end; i++)
+            task->map(vec_get(task->v, i), i, task->scratch);
+    }
+    else
+    {
+        for (i = task->start; i < task->end; i++)
+            task->reduce(task->acc, vec_get(task->v, i), i, task->scratch);
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Run every task, in parallel where possible, and wait for them all.
+ *
+ * The first task always runs on the calling thread. If a thread cannot be
+ * started for another task, it runs on the calling thread too.
+ *
+ * \param [in] tasks Tasks to run.
+ * \param [in] ntasks Number of tasks in \p tasks.
+ */
+static void _run_all(struct vecpar_task *tasks, unsigned ntasks)
+{
+    unsigned i;
+
+    for (i = 1; i < ntasks; i++)
+    {
+        if (tasks[i].start < tasks[i].end
+                && pthread_create(&tasks[i].thread, NULL, _run, &tasks[i]) == 0)
+            tasks[i].started = 1;
+    }
+
+    _run(&tasks[0]);
+
+    for (i = 1; i < ntasks; i++)
+    {
+        if (tasks[i].started)
+            pthread_join(tasks[i].thread, NULL);
+        else
+            _run(&tasks[i]);
+    }
+}
+
+/**
+ * \brief Clamp the requested number of threads to a usable value.
+ *
+ * \param [in] v Vector that will be split between the threads.
+ * \param [in] nthreads Number of threads requested by the caller.
+ *
+ * \return Returns the number of threads to use, between \c 1 and
+ * #VECPAR_MAX_THREADS.
+ */
+static unsigned _nthreads(const struct vector *v, unsigned nthreads)
+{
+    if (nthreads == 0)
+        nthreads = 1;
+    if (nthreads > VECPAR_MAX_THREADS)
+        nthreads = VECPAR_MAX_THREADS;
+
+    /* There is no point in starting more threads than there are cache lines
+     * of work to hand out.
+     */
+    if (nthreads > vec_len(v) / _granularity(v->elemsize))
+        nthreads = vec_len(v) / _granularity(v->elemsize);
+
+    return (nthreads > 0) ? nthreads : 1;
+}
+
+/**
+ * \brief Apply an operator to each element in a vector, using several threads.
+ *
+ * This is the parallel version of #vec_map(). The operator is called exactly
+ * once for each element, but in no particular order, and from up to \p
+ * nthreads threads at once. The operator must therefore be safe to call
+ * concurrently on different elements; in particular, any updates it makes
+ * through \p scratch need to be synchronized.
+ *
+ * \param [in,out] v Vector to map the operator over.
+ * \param [in] op Operator to apply to each element.
+ * \param [in] scratch Scratch argument passed directly to \p op.
+ * \param [in] nthreads Maximum number of threads to use, including the calling
+ * thread. Passing \c 1 is equivalent to calling #vec_map().
+ *
+ * \pre <tt>v != NULL</tt>
+ * \pre <tt>op != NULL</tt>
+ */
+void vec_pmap(struct vector *v, vec_operator op, void *scratch,
+        unsigned nthreads)
+{
+    struct vecpar_task tasks[VECPAR_MAX_THREADS];
+    unsigned i;
+
+    assert(v != NULL);
+    assert(op != NULL);
+
+    nthreads = _nthreads(v, nthreads);
+    _split(v, tasks, nthreads);
+
+    for (i = 0; i < nthreads; i++)
+    {
+        tasks[i].map = op;
+        tasks[i].reduce = NULL;
+        tasks[i].acc = NULL;
+        tasks[i].scratch = scratch;
+    }
+
+    _run_all(tasks, nthreads);
+}
+
+/**
+ * \brief Fold each element of a vector into an accumulator, using several
+ * threads.
+ *
+ * This is the parallel version of #vec_reduce(). Each thread gets its own copy
+ * of the initial value of \p acc, and folds its chunk of the vector into that
+ * copy with \p op, in index order. The per-thread results are then folded back
+ * into \p acc with \p combine, in chunk order. The initial value of \p acc must
+ * therefore be an identity for \p combine (e.g. \c 0 for a sum), and \p combine
+ * must be associative.
+ *
+ * The per-thread accumulators are allocated with \c malloc(), since the
+ * buffer of the vector may not be managed by a general allocator at all. Each
+ * one is padded out to whole cache lines, so that the threads do not contend
+ * for a cache line when they update small accumulators.
+ *
+ * \param [in] v Vector to reduce.
+ * \param [in,out] acc Accumulator; holds the identity on entry, and the result
+ * on return.
+ * \param [in] accsize Size of the accumulator, in bytes.
+ * \param [in] op Function for folding an element into an accumulator.
+ * \param [in] combine Function for folding one accumulator into another.
+ * \param [in] scratch Scratch argument passed to \p op and \p combine.
+ * \param [in] nthreads Maximum number of threads to use, including the calling
+ * thread.
+ *
+ * \return Returns \c 0 on success. Returns \c -1 if the per-thread accumulators
+ * could not be allocated, in which case \p acc is unchanged.
+ *
+ * \pre <tt>v != NULL</tt>
+ * \pre <tt>acc != NULL</tt>
+ * \pre <tt>op != NULL</tt>
+ * \pre <tt>combine != NULL</tt>
+ */
+int vec_preduce(const struct vector *v, void *acc, size_t accsize,
+        vec_reducer op, vec_combiner combine, void *scratch,
+        unsigned nthreads)
+{
+    struct vecpar_task tasks[VECPAR_MAX_THREADS];
+    char *block, *accs;
+    size_t stride;
+    unsigned i;
+
+    assert(v != NULL);
+    assert(acc != NULL);
+    assert(op != NULL);
+    assert(combine != NULL);
+
+    nthreads = _nthreads(v, nthreads);
+
+    /* A single thread can just fold straight into the result. */
+    if (nthreads == 1)
+    {
+        vec_reduce(v, acc, op, scratch);
+        return 0;
+    }
+
+    /* Give each accumulator its own cache lines. The allocator makes no
+     * promise about alignment, so allocate an extra line to align within. */
+    stride = (accsize + VECPAR_CACHE_LINE - 1)
+        / VECPAR_CACHE_LINE * VECPAR_CACHE_LINE;
+    block = malloc(nthreads * stride + VECPAR_CACHE_LINE - 1);
+    if (block == NULL)
+        return -1;
+
+    accs = block + (VECPAR_CACHE_LINE - (uintptr_t)block % VECPAR_CACHE_LINE)
+        % VECPAR_CACHE_LINE;
+
+    _split(v, tasks, nthreads);
+
+    for (i = 0; i < nthreads; i++)
+    {
+        memcpy(accs + i*stride, acc, accsize);
+        tasks[i].map = NULL;
+        tasks[i].reduce = op;
+        tasks[i].acc = accs + i*stride;
+        tasks[i].scratch = scratch;
+    }
+
+    _run_all(tasks, nthreads);
+
+    for (i = 0; i < nthreads; i++)
+        combine(acc, accs + i*stride, scratch);
+
+    free(block);
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or distribute
+ * this software, either in source code form or as a compiled binary, for any
+ * purpose, commercial or non-commercial, and by any means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors of this
+ * software dedicate any and all copyright interest in the software to the
+ * public domain. We make this dedication for the benefit of the public at large
+ * and to the detriment of our heirs and successors. We intend this dedication
+ * to be an overt act of relinquishment in perpetuity of all present and future
+ * rights to this software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+
+/**
+ * \file vecpar.h
+ *
+ * \brief Parallel operations over vectors.
+ *
+ * Splits a vector into contiguous chunks and runs #vec_map() or #vec_reduce()
+ * style operations on each chunk in its own thread. The chunk boundaries are
+ * placed on #VECPAR_CACHE_LINE boundaries of the buffer, so two threads never
+ * write to the same cache line of the vector. If the buffer is less aligned
+ * than the elements (e.g. 32-byte elements in a buffer that is only 16-byte
+ * aligned), no element starts on a cache line and this cannot be guaranteed;
+ * use #vec_init_aligned() with an alignment of #VECPAR_CACHE_LINE to avoid
+ * this.
+ *
+ * The calling thread always processes the first chunk itself, so a request for
+ * \c n threads only starts <tt>n - 1</tt> new ones. If a thread cannot be
+ * started, its chunk is processed by the calling thread instead; the operation
+ * still completes, just with less parallelism.
+ *
+ * \copyright This is free and unencumbered software released into the public
+ * domain.
+ */
+
+#ifndef _VECPAR_H_
+#define _VECPAR_H_
+
+
+#include "vector.h"
+
+/**
+ * \brief Size of a cache line, in bytes.
+ *
+ * Chunk boundaries are placed at addresses that are multiples of this many
+ * bytes, to avoid false sharing between the threads.
+ */
+#define VECPAR_CACHE_LINE 64
+
+/**
+ * \brief Maximum number of threads used by a single operation.
+ */
+#define VECPAR_MAX_THREADS 64
+
+void vec_pmap(struct vector *v, vec_operator op, void *scratch,
+        unsigned nthreads);
+int vec_preduce(const struct vector *v, void *acc, size_t accsize,
+        vec_reducer op, vec_combiner combine, void *scratch,
+        unsigned nthreads);
+
+
+#endif /* end of include guard: _VECPAR_H_ */
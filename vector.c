@@ -23,6 +23,7 @@
  */
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -30,6 +31,13 @@
 
 /* Check if the vector has enough space to grow. */
 static int _vec_checkspace(struct vector *v);
+/* Make sure the vector has enough space for 'n' more elements. */
+static int _vec_makeroom(struct vector *v, size_t n);
+/* Swap two non-overlapping blocks of memory. */
+static void _vec_memswap(void *a, void *b, size_t n);
+/* Sort an array with introsort. */
+static void _vec_introsort(char *base, size_t len, size_t size, cmp_func cmp,
+        size_t depth);
 
 /* Initialize a vector. */
 int vec_init(struct vector *v, size_t elemsize, size_t len,
@@ -67,10 +75,44 @@ int vec_init(struct vector *v, size_t elemsize, size_t len,
      */
     v->data = NULL;
     v->realloc = alloc;
+    v->resize = NULL;
+
+    /* Vectors double in size by default. */
+    v->grow = vec_grow_double;
+    v->growparam = 0;
+
+    /* The buffer is managed entirely by 'alloc'. */
+    v->align = 0;
+    v->flags = 0;
+    v->fd = -1;
 
     return vec_resize(v, size);
 }
 
+/* Initialize a vector that starts out in the caller's buffer 'buf'. */
+void vec_init_inline(struct vector *v, size_t elemsize, void *buf, size_t len,
+        void *(*alloc)(void *, size_t))
+{
+    assert(v != NULL);
+    assert(elemsize != 0);
+    assert(buf != NULL);
+    assert(len != 0);
+
+    v->len = 0;
+    v->elemsize = elemsize;
+    v->realloc = alloc;
+    v->resize = NULL;
+    v->grow = vec_grow_double;
+    v->growparam = 0;
+    v->align = 0;
+
+    /* No memory is allocated until the vector outgrows 'buf'. */
+    v->data = buf;
+    v->space = len;
+    v->flags = VEC_INLINE;
+    v->fd = -1;
+}
+
 /* Resize the buffer used by the vector. */
 int vec_resize(struct vector *v, size_t size)
 {
@@ -80,7 +122,33 @@ int vec_resize(struct vector *v, size_t size)
 
     assert(v != NULL);
 
-    blk = (void *)v->realloc(v->data, size);
+    /* The inline buffer of a small vector is never shrunk or freed; it is just
+     * abandoned for a heap buffer once the vector outgrows it.
+     */
+    if (v->flags & VEC_INLINE)
+    {
+        if (size <= v->space * v->elemsize)
+            return 0;
+
+        blk = (void *)v->realloc(NULL, size);
+        if (blk != NULL)
+        {
+            memcpy(blk, v->data, vec_len(v) * v->elemsize);
+            v->flags &= ~VEC_INLINE;
+        }
+    }
+    /* Aligned and file-backed vectors can't use a realloc()-style allocator;
+     * vec_init_aligned() and vec_open() set up their own.
+     */
+    else if (v->align != 0 || (v->flags & VEC_FILE))
+    {
+        size = (size / v->elemsize) * v->elemsize;
+        blk = v->resize(v, size);
+    }
+    else
+    {
+        blk = (void *)v->realloc(v->data, size);
+    }
 
     /* Check to see if the allocation succeeded. If it failed, need to return -1
      * while preserving the original buffer.
@@ -227,35 +295,32 @@ void vec_map(struct vector *v, vec_operator op, void *scratch)
     }
 }
 
+/* Fold every element of a vector into an accumulator. */
+void vec_reduce(const struct vector *v, void *acc, vec_reducer op,
+        void *scratch)
+{
+    size_t i;
+
+    assert(v != NULL);
+    assert(op != NULL);
+
+    /* The accumulator is updated in place, in index order. */
+    for (i = 0; i < vec_len(v); i++)
+        op(acc, vec_get(v, i), i, scratch);
+}
+
 /* Swap two elements in the vector. */
 void vec_swap(struct vector *v, size_t i, size_t j)
 {
-    void *buf;
-    void *_tmp;
-
     assert(v != NULL);
     assert(i < vec_len(v));
     assert(j < vec_len(v));
 
-    /* Use the last (empty) element for temporary storage. */
-    buf = (void *)(v->data + (v->space - 1)*v->elemsize);
-
     /* memcpy can't handle overlapping regions, so need to check this here. */
     if (i == j)
         return;
 
-    /* Get element i, and store it in a temporary variable. */
-    _tmp = vec_get(v, i);
-    memcpy(buf, _tmp, v->elemsize);
-
-    /*
-     * Set the ith  element to the value of the jth element. The ith element is
-     * still stored in tmp.
-     */
-    vec_set(v, i, vec_get(v, j));
-
-    /* Now move the temporary value into the jth element. */
-    vec_set(v, j, buf);
+    _vec_memswap(vec_get(v, i), vec_get(v, j), v->elemsize);
 }
 
 /* Free all the memory associated with the vector. */
@@ -263,7 +328,11 @@ void vec_destroy(struct vector *v)
 {
     assert(v != NULL);
 
+    /* Resizing to nothing releases the buffer. For a file-backed vector, this
+     * just unmaps and closes the file, which keeps its contents.
+     */
     vec_resize(v, 0);
+    v->fd = -1;
 }
 
 /* Get the total number of elements currently stored in the given vector. */
@@ -290,9 +359,13 @@ int vec_shrink(struct vector *v)
     assert(v != NULL);
 
     /* New size is the number of elements times the size of each element. Note
-     * that one extra slot is allocated, as it is needed by vec_swap().
+     * that an empty vector still keeps room for a single element, since
+     * resizing to 0 bytes would free the buffer.
      */
-    return vec_resize(v, (vec_len(v) + 1) * v->elemsize);
+    if (vec_isempty(v))
+        return vec_resize(v, v->elemsize);
+    else
+        return vec_resize(v, vec_len(v) * v->elemsize);
 }
 
 /* Determines if the vector is empty. */
@@ -321,34 +394,588 @@ void vec_set(struct vector *v, size_t i, const void *e)
     memcpy(v->data + i*v->elemsize, e, v->elemsize);
 }
 
-/* Check to make sure there is enough space in the vector for adding another
- * element. If there is not enough space, double the size of the buffer.
+/* Append 'n' elements from the array 'src' to the end of the vector. */
+int vec_extend(struct vector *v, const void *src, size_t n)
+{
+    assert(v != NULL);
+    assert(src != NULL || n == 0);
+
+    /* Appending is just inserting at the tail, so reuse that code. */
+    return vec_insert_range(v, vec_len(v), src, n);
+}
+
+/* Insert 'n' elements from the array 'src' before the element at index 'i'.
+ * The array may be part of the vector itself.
  */
-static int _vec_checkspace(struct vector *v)
+int vec_insert_range(struct vector *v, size_t i, const void *src, size_t n)
 {
     int rc;
+    int alias;
+    char *dst;
+    const char *from;
+    size_t off, bytes, head;
 
     assert(v != NULL);
+    assert(src != NULL || n == 0);
+    assert(i <= vec_len(v));
 
-    /*
-     * Check if the vector is full (i.e. the buffer cannot fit another element
-     * without resizing).
+    /* If 'src' points into the vector, growing the buffer would leave it
+     * dangling, so remember where it is relative to the buffer instead.
+     */
+    alias = v->data != NULL && (uintptr_t)src >= (uintptr_t)v->data
+        && (uintptr_t)src < (uintptr_t)(v->data + vec_len(v)*v->elemsize);
+    off = alias ? (size_t)((uintptr_t)src - (uintptr_t)v->data) : 0;
+
+    /* Grow the buffer once for the whole range, rather than once per element.
+     * If this fails, the vector is left unchanged.
      */
-    if (vec_len(v) == vec_space(v) - 1)
+    rc = _vec_makeroom(v, n);
+
+    if (rc == 0 && n > 0)
     {
-        /* If it is full, double the space used by the buffer. */
-        rc = vec_resize(v, 2 * vec_len(v) * v->elemsize);
+        dst = v->data + i*v->elemsize;
+        bytes = n * v->elemsize;
+
+        /* Slide the tail of the vector up to open a gap for the new elements.
+         * The regions may overlap, so this needs to be a memmove().
+         */
+        memmove(dst + bytes, dst, (vec_len(v) - i) * v->elemsize);
+
+        /* Copy the new elements into the gap in a single pass. Elements of the
+         * vector itself that were at or after the gap have just moved up.
+         */
+        if (!alias)
+        {
+            memcpy(dst, src, bytes);
+        }
+        else
+        {
+            from = v->data + off;
+            head = (from < dst) ? (size_t)(dst - from) : 0;
+            if (head > bytes)
+                head = bytes;
+
+            memcpy(dst, from, head);
+            memcpy(dst + head, from + head + bytes, bytes - head);
+        }
+        v->len += n;
     }
-    else
+
+    return rc;
+}
+
+/* Remove the 'n' elements starting at index 'i' from the vector. */
+void vec_erase_range(struct vector *v, size_t i, size_t n)
+{
+    char *dst;
+
+    assert(v != NULL);
+    assert(i <= vec_len(v));
+    assert(n <= vec_len(v) - i);
+
+    dst = v->data + i*v->elemsize;
+
+    /* Slide everything after the erased range down over the gap. Note that the
+     * buffer is never shrunk here, just like vec_pop().
+     */
+    memmove(dst, dst + n*v->elemsize, (vec_len(v) - i - n) * v->elemsize);
+    v->len -= n;
+}
+
+/* Make sure the vector can hold at least 'n' elements without resizing. */
+int vec_reserve(struct vector *v, size_t n)
+{
+    assert(v != NULL);
+
+    /* Reserving never shrinks the buffer; use vec_shrink() for that. */
+    if (n <= vec_space(v))
+        return 0;
+
+    /* The size of the buffer in bytes must fit in a size_t. */
+    if (n > SIZE_MAX / v->elemsize)
+        return -1;
+
+    return vec_resize(v, n * v->elemsize);
+}
+
+/* Set the rule used for growing the vector when it runs out of space. */
+void vec_setgrowth(struct vector *v, vec_grow_func grow, size_t param)
+{
+    assert(v != NULL);
+    assert(grow != NULL);
+
+    v->grow = grow;
+    v->growparam = param;
+}
+
+/* Growth rule: double the space until the new elements fit. If doubling
+ * would overflow, just make room for the new elements.
+ */
+size_t vec_grow_double(size_t space, size_t needed, size_t param)
+{
+    (void)param;
+
+    if (space == 0)
+        space = 1;
+
+    while (space < needed)
     {
-        /* If it is not full, no need to resize; always succeeds. */
-        rc = 0;
+        if (space > SIZE_MAX / 2)
+            return needed;
+        space *= 2;
     }
 
-    /*
-     * Return code was set by the call to vec_resize if the buffer was resized.
-     * Otherwise, the code was zeroed.
+    return space;
+}
+
+/* Growth rule: grow the space by half until the new elements fit. */
+size_t vec_grow_onehalf(size_t space, size_t needed, size_t param)
+{
+    size_t step;
+
+    (void)param;
+
+    /* Small buffers would never grow by half when rounding down, so always add
+     * at least one element. If growing would overflow, just make room for the
+     * new elements.
      */
-    return rc;
+    while (space < needed)
+    {
+        step = (space / 2 > 0) ? space / 2 : 1;
+        if (space > SIZE_MAX - step)
+            return needed;
+        space += step;
+    }
+
+    return space;
+}
+
+/* Growth rule: add 'param' elements at a time until the new elements fit. */
+size_t vec_grow_chunk(size_t space, size_t needed, size_t param)
+{
+    size_t chunks;
+
+    assert(param != 0);
+
+    /* Round the shortfall up to a whole number of chunks, unless that would
+     * overflow.
+     */
+    if (space < needed)
+    {
+        chunks = (needed - space) / param
+            + ((needed - space) % param != 0);
+        if (chunks > (SIZE_MAX - space) / param)
+            return needed;
+        space += chunks * param;
+    }
+
+    return space;
+}
+
+/* Sort the elements of the vector in place. */
+void vec_sort(struct vector *v, cmp_func cmp)
+{
+    size_t depth;
+    size_t n;
+
+    assert(v != NULL);
+    assert(cmp != NULL);
+
+    /* Quicksort is allowed to recurse 2*log2(n) deep before giving up and
+     * switching to heapsort, which bounds the worst case to O(n log n).
+     */
+    depth = 0;
+    for (n = vec_len(v); n > 1; n >>= 1)
+        depth += 2;
+
+    _vec_introsort(v->data, vec_len(v), v->elemsize, cmp, depth);
+}
+
+/* Read an unsigned integer key of 'keysize' bytes from 'e'. */
+static uint64_t _vec_readkey(const char *e, size_t keysize)
+{
+    uint8_t k8;
+    uint16_t k16;
+    uint32_t k32;
+    uint64_t k64;
+
+    switch (keysize)
+    {
+    case 1:
+        memcpy(&k8, e, sizeof(k8));
+        return k8;
+    case 2:
+        memcpy(&k16, e, sizeof(k16));
+        return k16;
+    case 4:
+        memcpy(&k32, e, sizeof(k32));
+        return k32;
+    default:
+        assert(keysize == 8);
+        memcpy(&k64, e, sizeof(k64));
+        return k64;
+    }
 }
 
+/* Sort the elements of the vector by an unsigned integer key. */
+int vec_radixsort(struct vector *v, size_t keyoff, size_t keysize)
+{
+    size_t counts[sizeof(uint64_t)][256];
+    size_t sum, tmp;
+    size_t i, pass, b;
+    char *src, *dst, *buf;
+    uint64_t key;
+
+    assert(v != NULL);
+    assert(keysize == 1 || keysize == 2 || keysize == 4 || keysize == 8);
+    assert(keyoff + keysize <= v->elemsize);
+
+    if (vec_len(v) < 2)
+        return 0;
+
+    /* The elements are scattered back and forth between the vector and a
+     * scratch buffer of the same size, once per byte of the key. Not every
+     * vector has a general allocator, so the scratch buffer comes from
+     * malloc().
+     */
+    buf = malloc(vec_len(v) * v->elemsize);
+    if (buf == NULL)
+        return -1;
+
+    /* Count the occurrences of every byte value for all passes at once, so
+     * that the keys only need to be read one extra time.
+     */
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < vec_len(v); i++)
+    {
+        key = _vec_readkey((char *)vec_get(v, i) + keyoff, keysize);
+        for (pass = 0; pass < keysize; pass++)
+            counts[pass][(key >> (8 * pass)) & 0xff]++;
+    }
+
+    src = v->data;
+    dst = buf;
+    for (pass = 0; pass < keysize; pass++)
+    {
+        /* If every key has the same byte here, this pass would not move
+         * anything, so skip it.
+         */
+        key = _vec_readkey(src + keyoff, keysize);
+        if (counts[pass][(key >> (8 * pass)) & 0xff] == vec_len(v))
+            continue;
+
+        /* Turn the counts into the index of the first element with each byte
+         * value.
+         */
+        sum = 0;
+        for (b = 0; b < 256; b++)
+        {
+            tmp = counts[pass][b];
+            counts[pass][b] = sum;
+            sum += tmp;
+        }
+
+        /* Scatter the elements by this byte of the key. This is stable, so
+         * the order from earlier passes is kept for equal bytes.
+         */
+        for (i = 0; i < vec_len(v); i++)
+        {
+            key = _vec_readkey(src + i*v->elemsize + keyoff, keysize);
+            b = (key >> (8 * pass)) & 0xff;
+            memcpy(dst + counts[pass][b]*v->elemsize, src + i*v->elemsize,
+                    v->elemsize);
+            counts[pass][b]++;
+        }
+
+        buf = src;
+        src = dst;
+        dst = buf;
+    }
+
+    /* After an odd number of passes the result is in the scratch buffer. */
+    if (src != v->data)
+    {
+        memcpy(v->data, src, vec_len(v) * v->elemsize);
+        dst = src;
+    }
+
+    free(dst);
+
+    return 0;
+}
+
+/* Find the first element that is not less than 'key'. */
+size_t vec_lower_bound(const struct vector *v, const void *key, cmp_func cmp)
+{
+    size_t lo, hi, mid;
+
+    assert(v != NULL);
+    assert(cmp != NULL);
+
+    lo = 0;
+    hi = vec_len(v);
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (cmp(key, vec_get(v, mid)) > 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/* Find the first element that is greater than 'key'. */
+size_t vec_upper_bound(const struct vector *v, const void *key, cmp_func cmp)
+{
+    size_t lo, hi, mid;
+
+    assert(v != NULL);
+    assert(cmp != NULL);
+
+    lo = 0;
+    hi = vec_len(v);
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (cmp(key, vec_get(v, mid)) >= 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/* Check to make sure there is enough space in the vector for adding another
+ * element. If there is not enough space, grow the buffer according to the
+ * growth rule of the vector.
+ */
+static int _vec_checkspace(struct vector *v)
+{
+    assert(v != NULL);
+
+    return _vec_makeroom(v, 1);
+}
+
+/* Check to make sure there is enough space in the vector for adding 'n' more
+ * elements. If there is not enough space, the growth rule is asked for a new
+ * size that fits all of them, so that a bulk insert only ever needs a single
+ * allocation.
+ */
+static int _vec_makeroom(struct vector *v, size_t n)
+{
+    size_t needed;
+    size_t space;
+    size_t max;
+
+    assert(v != NULL);
+    assert(v->grow != NULL);
+
+    max = SIZE_MAX / v->elemsize;
+
+    /* The size of the buffer in bytes must fit in a size_t. */
+    if (n > max - vec_len(v))
+        return -1;
+
+    needed = vec_len(v) + n;
+    if (needed <= vec_space(v))
+        return 0;
+
+    /* The growth rule does not know the element size, so clamp its answer. */
+    space = v->grow(vec_space(v), needed, v->growparam);
+    assert(space >= needed);
+    if (space > max)
+        space = max;
+
+    return vec_resize(v, space * v->elemsize);
+}
+
+/* Swap the 'n' bytes at 'a' with the 'n' bytes at 'b'. The blocks must not
+ * overlap. Large blocks are exchanged through a small buffer on the stack, one
+ * chunk at a time, so that elements of any size can be swapped without needing
+ * any scratch space in the vector itself. Whatever is left is swapped a word at
+ * a time; the fixed-size copies compile down to plain loads and stores.
+ */
+static void _vec_memswap(void *a, void *b, size_t n)
+{
+    unsigned char buf[VEC_SWAP_CHUNK];
+    unsigned char *_a = a;
+    unsigned char *_b = b;
+    unsigned char c;
+    uint64_t x, y;
+
+    assert(a != NULL);
+    assert(b != NULL);
+
+    for (; n >= sizeof(buf); n -= sizeof(buf))
+    {
+        memcpy(buf, _a, sizeof(buf));
+        memcpy(_a, _b, sizeof(buf));
+        memcpy(_b, buf, sizeof(buf));
+
+        _a += sizeof(buf);
+        _b += sizeof(buf);
+    }
+
+    for (; n >= sizeof(x); n -= sizeof(x))
+    {
+        memcpy(&x, _a, sizeof(x));
+        memcpy(&y, _b, sizeof(y));
+        memcpy(_a, &y, sizeof(y));
+        memcpy(_b, &x, sizeof(x));
+
+        _a += sizeof(x);
+        _b += sizeof(x);
+    }
+
+    for (; n > 0; n--)
+    {
+        c = *_a;
+        *_a++ = *_b;
+        *_b++ = c;
+    }
+}
+
+/* Get a pointer to element 'i' of the array 'base' of 'size'-byte elements. */
+#define _vec_elem(base, i, size)    ((base) + (i)*(size))
+
+/* Sort a short array with insertion sort, swapping each element down into
+ * place.
+ */
+static void _vec_insertsort(char *base, size_t len, size_t size, cmp_func cmp)
+{
+    size_t i, j;
+
+    for (i = 1; i < len; i++)
+    {
+        for (j = i; j > 0 && cmp(_vec_elem(base, j - 1, size),
+                    _vec_elem(base, j, size)) > 0; j--)
+        {
+            _vec_memswap(_vec_elem(base, j - 1, size),
+                    _vec_elem(base, j, size), size);
+        }
+    }
+}
+
+/* Sift element 'i' down through the max-heap formed by the first 'len'
+ * elements of 'base'.
+ */
+static void _vec_heapdown(char *base, size_t i, size_t len, size_t size,
+        cmp_func cmp)
+{
+    size_t c;
+
+    for (c = 2*i + 1; c < len; i = c, c = 2*i + 1)
+    {
+        /* Pick the larger child. */
+        if (c + 1 < len && cmp(_vec_elem(base, c, size),
+                    _vec_elem(base, c + 1, size)) < 0)
+            c++;
+
+        if (cmp(_vec_elem(base, i, size), _vec_elem(base, c, size)) >= 0)
+            break;
+
+        _vec_memswap(_vec_elem(base, i, size), _vec_elem(base, c, size), size);
+    }
+}
+
+/* Sort an array with heapsort. This is the fallback when quicksort keeps
+ * picking bad pivots.
+ */
+static void _vec_heapsort(char *base, size_t len, size_t size, cmp_func cmp)
+{
+    size_t i;
+
+    for (i = len / 2; i > 0; i--)
+        _vec_heapdown(base, i - 1, len, size, cmp);
+
+    for (i = len - 1; i > 0; i--)
+    {
+        _vec_memswap(base, _vec_elem(base, i, size), size);
+        _vec_heapdown(base, 0, i, size, cmp);
+    }
+}
+
+/* Sort an array with introsort: quicksort with a median-of-three pivot, falling
+ * back to heapsort once 'depth' levels of partitioning have been used up, and
+ * finishing short ranges with insertion sort. Only the smaller side of each
+ * partition is sorted recursively, so the stack depth is O(log n). Elements are
+ * only ever exchanged in place, so no scratch space is needed.
+ */
+static void _vec_introsort(char *base, size_t len, size_t size, cmp_func cmp,
+        size_t depth)
+{
+    char *pivot;
+    size_t i, j;
+
+    while (len > VEC_SORT_CUTOFF)
+    {
+        if (depth == 0)
+        {
+            _vec_heapsort(base, len, size, cmp);
+            return;
+        }
+        depth--;
+
+        /* Order the first, middle and last elements, then move the median to
+         * the front to use as the pivot. The pivot stays there (and so 'pivot'
+         * stays valid) until partitioning is done.
+         */
+        pivot = base;
+        i = len / 2;
+        j = len - 1;
+        if (cmp(_vec_elem(base, i, size), pivot) < 0)
+            _vec_memswap(_vec_elem(base, i, size), pivot, size);
+        if (cmp(_vec_elem(base, j, size), pivot) < 0)
+            _vec_memswap(_vec_elem(base, j, size), pivot, size);
+        if (cmp(_vec_elem(base, j, size), _vec_elem(base, i, size)) < 0)
+            _vec_memswap(_vec_elem(base, j, size), _vec_elem(base, i, size),
+                    size);
+        _vec_memswap(_vec_elem(base, i, size), pivot, size);
+
+        /* Hoare partition. Both scans stop on elements equal to the pivot, so
+         * runs of equal keys still split evenly.
+         */
+        i = 0;
+        j = len;
+        for (;;)
+        {
+            do
+                i++;
+            while (i < len && cmp(_vec_elem(base, i, size), pivot) < 0);
+
+            do
+                j--;
+            while (cmp(_vec_elem(base, j, size), pivot) > 0);
+
+            if (i >= j)
+                break;
+
+            _vec_memswap(_vec_elem(base, i, size), _vec_elem(base, j, size),
+                    size);
+        }
+
+        /* Move the pivot between the two halves; it is now in place. */
+        _vec_memswap(pivot, _vec_elem(base, j, size), size);
+
+        /* Recurse into the smaller half and loop on the larger one. */
+        if (j < len - j - 1)
+        {
+            _vec_introsort(base, j, size, cmp, depth);
+            base = _vec_elem(base, j + 1, size);
+            len = len - j - 1;
+        }
+        else
+        {
+            _vec_introsort(_vec_elem(base, j + 1, size), len - j - 1, size, cmp,
+                    depth);
+            len = j;
+        }
+    }
+
+    _vec_insertsort(base, len, size, cmp);
+}
@@ -30,23 +30,80 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "utils.h"
+
 /* Default vector length. */
 #define DEF_VEC_LEN    32
 
+/* Number of bytes swapped at a time by vec_swap(). */
+#define VEC_SWAP_CHUNK 64
+
+/* Ranges at most this long are finished with insertion sort by vec_sort(). */
+#define VEC_SORT_CUTOFF 16
+
+/* Flag for vec_init_aligned() (see vecaligned.h): back large buffers with huge
+ * pages. */
+#define VEC_HUGEPAGE        0x1
+
+/* Flag set while a vector is still using its inline buffer. */
+#define VEC_INLINE          0x2
+
+/* Flag set on vectors stored in a memory-mapped file (see vecfile.h). */
+#define VEC_FILE            0x4
+
+
+/*
+ * Rule for growing a vector. Given the current space and the number of elements
+ * that must fit, returns the new space (at least 'needed'). The 'param'
+ * argument is the value passed to vec_setgrowth(). The vector clamps the result
+ * to the most elements whose total size fits in a size_t.
+ */
+typedef size_t (*vec_grow_func)(size_t space, size_t needed, size_t param);
+
 
 struct vector
 {
     char *data;
     void *(*realloc)(void *, size_t);
+    void *(*resize)(const struct vector *, size_t);
     size_t len;
     size_t elemsize;
     size_t space;
+    vec_grow_func grow;
+    size_t growparam;
+    size_t align;
+    unsigned flags;
+    int fd;
 };
 
 
+/*
+ * Declare a vector with room for 'N' elements of 'type' stored inline, e.g.
+ *
+ *     struct { VEC_INLINE_DECL(int, 8); } adj;
+ *     VEC_INLINE_INIT(&adj, realloc);
+ *
+ * The vector is 'adj.vec'. Nothing is allocated until it holds more than 'N'
+ * elements. Since the vector points into the structure, the structure must not
+ * be moved or copied while the inline buffer is in use.
+ */
+#define VEC_INLINE_DECL(type, N)    struct vector vec; type buf[N]
+
+/* Initialize a vector declared with VEC_INLINE_DECL(). */
+#define VEC_INLINE_INIT(s, alloc) \
+    vec_init_inline(&(s)->vec, sizeof(*(s)->buf), (s)->buf, \
+            sizeof((s)->buf) / sizeof(*(s)->buf), (alloc))
+
+
 /* Function for operating on elements of a vector. */
 typedef void (*vec_operator)(void *e, size_t i, void *scratch);
 
+/* Function for folding an element of a vector into an accumulator. */
+typedef void (*vec_reducer)(void *acc, const void *e, size_t i, void *scratch);
+
+/* Function for combining two accumulators, storing the result in the first. */
+typedef void (*vec_combiner)(void *acc, const void *other, void *scratch);
+
 
 /*
  * Vector Operations
@@ -55,6 +112,9 @@ typedef void (*vec_operator)(void *e, size_t i, void *scratch);
 /* Initialize a vector. */
 int vec_init(struct vector *v, size_t elemsize, size_t len,
         void *(*alloc)(void *, size_t));
+/* Initialize a vector that starts out using a caller-supplied buffer. */
+void vec_init_inline(struct vector *v, size_t elemsize, void *buf, size_t len,
+        void *(*alloc)(void *, size_t));
 /* Resize a vector. */
 int vec_resize(struct vector *v, size_t size);
 /* Get the first element of a vector. */
@@ -67,6 +127,9 @@ int vec_push(struct vector *v, const void *e);
 int vec_pop(struct vector *v);
 /* Operate on each element in the vector. */
 void vec_map(struct vector *v, vec_operator op, void *scratch);
+/* Fold each element in the vector into an accumulator. */
+void vec_reduce(const struct vector *v, void *acc, vec_reducer op,
+        void *scratch);
 /* Swap two elements in the vector. */
 void vec_swap(struct vector *v, size_t i, size_t j);
 /* Deallocate a vector. */
@@ -83,6 +146,103 @@ int vec_isempty(const struct vector *v);
 void *vec_get(const struct vector *v, size_t i);
 /* Set an element of a vector. */
 void vec_set(struct vector *v, size_t i, const void *e);
+/* Add an array of elements to the end of a vector. The array may be part of
+ * the vector itself. */
+int vec_extend(struct vector *v, const void *src, size_t n);
+/* Insert an array of elements at the given index. The array may be part of
+ * the vector itself. */
+int vec_insert_range(struct vector *v, size_t i, const void *src, size_t n);
+/* Remove a range of elements starting at the given index. */
+void vec_erase_range(struct vector *v, size_t i, size_t n);
+/* Make sure a vector can hold some number of elements without resizing. */
+int vec_reserve(struct vector *v, size_t n);
+/* Set the rule used for growing a vector. */
+void vec_setgrowth(struct vector *v, vec_grow_func grow, size_t param);
+/* Sort the elements of a vector. */
+void vec_sort(struct vector *v, cmp_func cmp);
+/* Sort the elements of a vector by an unsigned integer key. */
+int vec_radixsort(struct vector *v, size_t keyoff, size_t keysize);
+/* Find the first element of a sorted vector that is not less than a key. */
+size_t vec_lower_bound(const struct vector *v, const void *key, cmp_func cmp);
+/* Find the first element of a sorted vector that is greater than a key. */
+size_t vec_upper_bound(const struct vector *v, const void *key, cmp_func cmp);
+
+/*
+ * Growth Rules
+ */
+
+/* Double the space of the vector. This is the default. */
+size_t vec_grow_double(size_t space, size_t needed, size_t param);
+/* Grow the space of the vector by half. */
+size_t vec_grow_onehalf(size_t space, size_t needed, size_t param);
+/* Grow the space of the vector by a fixed number of elements. */
+size_t vec_grow_chunk(size_t space, size_t needed, size_t param);
+
+
+/*
+ * Type-Specialized Vectors
+ */
+
+/*
+ * Define a set of 'static inline' functions named 'name_*' that operate on a
+ * vector of 'type' elements. The element size is known at compile time, so
+ * element access is a plain load or store instead of a multiply and memcpy(),
+ * and the compiler is free to inline and vectorize loops over the vector. The
+ * functions work on an ordinary 'struct vector', so they can be freely mixed
+ * with the generic vec_* functions; only pushes that need to grow the buffer
+ * call into vector.c, so the growth rule still applies.
+ */
+#define VECTOR_DEFINE(name, type)                                             \
+static inline int name##_init(struct vector *v, size_t len,                   \
+        void *(*alloc)(void *, size_t))                                       \
+{                                                                             \
+    return vec_init(v, sizeof(type), len, alloc);                             \
+}                                                                             \
+                                                                              \
+static inline type *name##_data(const struct vector *v)                       \
+{                                                                             \
+    assert(v != NULL);                                                        \
+    assert(v->elemsize == sizeof(type));                                      \
+    return (type *)v->data;                                                   \
+}                                                                             \
+                                                                              \
+static inline type *name##_at(const struct vector *v, size_t i)               \
+{                                                                             \
+    assert(i < v->len);                                                       \
+    return name##_data(v) + i;                                                \
+}                                                                             \
+                                                                              \
+static inline type name##_get(const struct vector *v, size_t i)               \
+{                                                                             \
+    return *name##_at(v, i);                                                  \
+}                                                                             \
+                                                                              \
+static inline void name##_set(struct vector *v, size_t i, type e)             \
+{                                                                             \
+    *name##_at(v, i) = e;                                                     \
+}                                                                             \
+                                                                              \
+static inline int name##_push(struct vector *v, type e)                       \
+{                                                                             \
+    /* Only call out of line if the buffer needs to grow. */                  \
+    if (v->len < v->space)                                                    \
+    {                                                                         \
+        name##_data(v)[v->len] = e;                                           \
+        return (int)v->len++;                                                 \
+    }                                                                         \
+    return vec_push(v, &e);                                                   \
+}                                                                             \
+                                                                              \
+static inline type name##_pop(struct vector *v)                               \
+{                                                                             \
+    assert(v->len > 0);                                                       \
+    return name##_data(v)[--v->len];                                          \
+}                                                                             \
+                                                                              \
+static inline size_t name##_len(const struct vector *v)                       \
+{                                                                             \
+    return v->len;                                                            \
+}
 
 
 #endif /* end of include guard: _VECTOR_H_ */